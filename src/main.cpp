@@ -15,11 +15,14 @@
 #include <cmath>
 #include <chrono>
 #include <ctime>
+#include <memory>
+#include <mutex>
 
 #include "simulator/simulation_context.h"
 #include "simulator/simulator.h"
 #include "utils/config.h"
 #include "utils/table_formatter.h"
+#include "utils/work_stealing_pool.h"
 
 // Network and routing factories
 #include "network/network_factory.h"
@@ -33,6 +36,76 @@ struct ExperimentResult {
     bool saturated;
 };
 
+// Outcome of one simulation run at one injection rate
+struct RunResult {
+    double delay;
+    double throughput;
+    size_t packetsReceived;
+    bool saturated;
+};
+
+/**
+ * Run every (rate, run) point of the sweep on a work-stealing pool.
+ * Each worker builds its own SimulationContext on first use over the shared,
+ * read-only topology, and each point is seeded from its indices, so results
+ * do not depend on scheduling.
+ */
+std::vector<std::vector<RunResult>> runSweep(const Config& config, const std::vector<double>& injectionRates,
+                                             const std::shared_ptr<const SimulationTopology>& topology) {
+    int runsPerRate = config.getRunsPerInjectionRate();
+    int totalPoints = static_cast<int>(injectionRates.size()) * runsPerRate;
+    
+    int threadCount = config.getThreadCount();
+    if (threadCount <= 0) {
+        // The parallel engines already spread each point over the cores
+        bool parallelEngine = config.getSimulationEngine() == "parallel" || config.getSimulationEngine() == "timewarp";
+        threadCount = parallelEngine ? 1 : WorkStealingPool::getDefaultThreadCount();
+    }
+    threadCount = std::max(1, std::min(threadCount, totalPoints));
+    
+    std::cout << "Running " << totalPoints << " simulation points on " 
+              << threadCount << " thread(s)" << std::endl;
+    
+    std::vector<std::vector<RunResult>> results(injectionRates.size(), std::vector<RunResult>(runsPerRate));
+    std::vector<std::unique_ptr<SimulationContext>> workerContexts(threadCount);
+    std::mutex setupMutex;
+    
+    WorkStealingPool pool(threadCount);
+    
+    // High rates take longest, so queue them first
+    for (size_t rateIndex = injectionRates.size(); rateIndex-- > 0;) {
+        for (int run = 0; run < runsPerRate; run++) {
+            pool.submit([&, rateIndex, run](int workerIndex) {
+                std::unique_ptr<SimulationContext>& context = workerContexts[workerIndex];
+                if (!context) {
+                    // Serialize setup so its console output stays readable
+                    std::lock_guard<std::mutex> lock(setupMutex);
+                    context.reset(new SimulationContext(config, topology));
+                    context->initialize();
+                }
+                Simulator* simulator = context->getSimulator();
+                
+                // Use more deterministic seed generation
+                unsigned int seed = 12345 + (rateIndex * 10000) + (run * 1000);
+                simulator->setSeed(seed);
+                simulator->runSimulation(injectionRates[rateIndex], config);
+                
+                auto metrics = simulator->getMetrics();
+                RunResult& result = results[rateIndex][run];
+                result.delay = metrics->getAveragePacketDelay();
+                result.throughput = metrics->getThroughput();
+                result.packetsReceived = metrics->getPacketCount();
+                result.saturated = metrics->isSaturated();
+                
+                simulator->reset();
+            });
+        }
+    }
+    
+    pool.wait();
+    return results;
+}
+
 // Fixed table display precision settings
 void printResultsTableFormatted(const std::vector<ExperimentResult>& results) {
     TableFormatter table("omni_simulator Experimental Results");
@@ -275,9 +348,6 @@ int main() {
         return 1;
     }
 
-    // Get the simulator from the context
-    Simulator* simulator = simulationContext.getSimulator();
-
     // Get injection rate list
     auto injectionRates = config.getPacketInjectionRates();
     std::cout << "Testing " << injectionRates.size() << " injection rates: ";
@@ -307,6 +377,15 @@ int main() {
     resultsFile << "# Simulation Date: " << getCurrentTimestamp() << "\n";
     resultsFile << "InjectionRate,AverageDelay,Throughput,Saturated\n";
 
+    // Run all simulation points in parallel, then report them in rate order
+    std::vector<std::vector<RunResult>> sweepResults;
+    try {
+        sweepResults = runSweep(config, injectionRates, simulationContext.getTopology());
+    } catch (const std::exception& e) {
+        std::cerr << "Simulation failed: " << e.what() << std::endl;
+        return 1;
+    }
+
     // Store experimental results for final display
     std::vector<ExperimentResult> experimentResults;
 
@@ -329,19 +408,11 @@ int main() {
         for (int run = 0; run < runsPerRate; run++) {
             std::cout << "  Run " << (run + 1) << "/" << runsPerRate;
             
-            // Use more deterministic seed generation
-            unsigned int seed = 12345 + (rateIndex * 10000) + (run * 1000);
-            srand(seed);
-            
-            // Run simulation
-            simulator->runSimulation(injectionRate, config);
-            
-            // Collect metrics
-            auto metrics = simulator->getMetrics();
-            double currentDelay = metrics->getAveragePacketDelay();
-            double currentThroughput = metrics->getThroughput();
-            size_t packetsReceived = metrics->getPacketCount();
-            bool currentSaturated = metrics->isSaturated();
+            const RunResult& runResult = sweepResults[rateIndex][run];
+            double currentDelay = runResult.delay;
+            double currentThroughput = runResult.throughput;
+            size_t packetsReceived = runResult.packetsReceived;
+            bool currentSaturated = runResult.saturated;
             
             std::cout << " - Delay: " << std::fixed << std::setprecision(3) << currentDelay 
                       << ", Throughput: " << std::setprecision(4) << currentThroughput 
@@ -358,8 +429,6 @@ int main() {
                 allSaturatedStates.push_back(true);
                 std::cout << "    (Network blocked)" << std::endl;
             }
-            
-            simulator->reset();
         }
         
         double avgDelay = 0.0;
@@ -0,0 +1,22 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "message/packet_pool.h"
+
+const PacketHandle PacketPool::kInvalidHandle;
+const size_t PacketPool::kInitialCapacity;
+
+PacketPool::PacketPool() {
+}
+
+void PacketPool::clear() {
+    // Records are trivially destructible, so both resets are constant time
+    // and keep their storage
+    records_.clear();
+    freeList_.clear();
+}
@@ -0,0 +1,88 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index of a record inside a PacketPool
+using PacketHandle = uint32_t;
+
+/**
+ * @brief Compact in-network packet record
+ *
+ * Node references are 32-bit node indices rather than Node pointers, so a
+ * record is 32 bytes and can be copied or relocated freely.
+ *
+ * The routing candidates computed at currentId are cached in the record
+ * and reused while the packet waits there; both masks are zero until the
+ * packet has been routed at its current node.
+ */
+struct PacketRecord {
+    uint32_t sourceId;
+    uint32_t destinationId;
+    uint32_t currentId;
+    int32_t injectionCycle;
+    int32_t hopCount;
+    uint32_t adaptivePorts;
+    uint32_t escapePorts;
+    uint8_t channel;
+};
+
+/**
+ * @brief Slab allocator with a free list for packet records
+ *
+ * Records live in one contiguous array that only grows while the network
+ * fills up; in steady state allocate() and release() just move handles on
+ * and off the free list. clear() drops every live record at once.
+ */
+class PacketPool {
+public:
+    static const PacketHandle kInvalidHandle = 0xFFFFFFFFu;
+
+    PacketPool();
+
+    PacketHandle allocate() {
+        if (!freeList_.empty()) {
+            PacketHandle handle = freeList_.back();
+            freeList_.pop_back();
+            return handle;
+        }
+        if (records_.size() == records_.capacity()) {
+            records_.reserve(records_.empty() ? kInitialCapacity : records_.size() * 2);
+        }
+        records_.emplace_back();
+        return static_cast<PacketHandle>(records_.size() - 1);
+    }
+
+    void release(PacketHandle handle) {
+        freeList_.push_back(handle);
+    }
+
+    PacketRecord& operator[](PacketHandle handle) { return records_[handle]; }
+    const PacketRecord& operator[](PacketHandle handle) const { return records_[handle]; }
+
+    /**
+     * @brief Release every record in O(1), keeping the slab for reuse
+     */
+    void clear();
+
+    size_t getLiveCount() const { return records_.size() - freeList_.size(); }
+    size_t getCapacity() const { return records_.capacity(); }
+
+private:
+    static const size_t kInitialCapacity = 1024;
+
+    std::vector<PacketRecord> records_;      // Sized to the high-water mark, so copies skip unused slab
+    std::vector<PacketHandle> freeList_;
+};
+
+#endif // PACKET_POOL_H
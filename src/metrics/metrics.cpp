@@ -3,59 +3,70 @@
 #include <numeric>
 #include <algorithm>
 #include <fstream>
+#include <stdexcept>
 
-Metrics::Metrics() : totalLatency(0.0), totalThroughput(0.0), count(0), totalPackets(0), totalFlits(0.0), 
+Metrics::Metrics() : totalPackets(0), totalFlits(0.0), 
                      measurementCycles(0), currentInjectionRate(0.0), isWarmupPhase(false), 
-                     isMeasurementPhase(false), currentCycle(0), saturated(false), totalHops(0), 
-                     congestionEvents(0) {
+                     isMeasurementPhase(false), currentCycle(0), saturated(false), 
+                     recordSamples(false), lastThroughputSample(0.0), previousThroughputSample(0.0),
+                     throughputSampleCount(0), congestionEvents(0) {
 }
 
 Metrics::~Metrics() {
 }
 
 void Metrics::recordLatency(double latency) {
-    latencies.push_back(latency);
-    totalLatency += latency;
-    count++;
+    latencyStats.add(latency);
 }
 
 void Metrics::recordThroughput(double throughput) {
-    throughputs.push_back(throughput);
-    throughputSamples.push_back(throughput);
-    totalThroughput += throughput;
+    throughputStats.add(throughput);
+    recordThroughputSample(throughput);
+}
+
+void Metrics::recordThroughputSample(double throughput) {
+    previousThroughputSample = lastThroughputSample;
+    lastThroughputSample = throughput;
+    throughputSampleCount++;
 }
 
 void Metrics::recordPacketLatency(double latencyCycles) {
-    packetLatencies.push_back(latencyCycles);
+    packetLatencyStats.add(latencyCycles);
+    packetLatencyHistogram.record(latencyCycles);
+    if (recordSamples) {
+        packetLatencySamples.push_back(latencyCycles);
+    }
     recordLatency(latencyCycles);
 }
 
 void Metrics::recordFlitThroughput(double flitsPerCyclePerNode) {
-    flitThroughputs.push_back(flitsPerCyclePerNode);
-    throughputSamples.push_back(flitsPerCyclePerNode);
+    flitThroughputStats.add(flitsPerCyclePerNode);
+    if (recordSamples) {
+        flitThroughputSamples.push_back(flitsPerCyclePerNode);
+    }
+    recordThroughputSample(flitsPerCyclePerNode);
     totalFlits += flitsPerCyclePerNode;
     recordThroughput(flitsPerCyclePerNode);
 }
 
 void Metrics::recordInjectionRate(double packetsPerCyclePerNode) {
-    injectionRates.push_back(packetsPerCyclePerNode);
+    if (recordSamples) {
+        injectionRateSamples.push_back(packetsPerCyclePerNode);
+    }
     currentInjectionRate = packetsPerCyclePerNode;
 }
 
 void Metrics::recordHopCount(int hops) {
-    hopCounts.push_back(hops);
-    totalHops += hops;
+    hopCountStats.add(hops);
+    hopHistogram.record(hops);
 }
 
 double Metrics::calculateAverageLatency() const {
-    return count > 0 ? totalLatency / count : 0.0;
+    return latencyStats.mean();
 }
 
 double Metrics::calculateThroughput() const {
-    if (throughputs.empty()) {
-        return 0.0;
-    }
-    return totalThroughput / throughputs.size();
+    return throughputStats.mean();
 }
 
 double Metrics::getAverageLatency() const {
@@ -63,34 +74,26 @@ double Metrics::getAverageLatency() const {
 }
 
 double Metrics::getThroughput() const {
-    if (!flitThroughputs.empty()) {
-        double sum = 0.0;
-        for (double throughput : flitThroughputs) {
-            sum += throughput;
-        }
-        return sum / flitThroughputs.size();
+    if (!flitThroughputStats.empty()) {
+        return flitThroughputStats.mean();
     }
     
     return calculateThroughput();
 }
 
 double Metrics::getAveragePacketDelay() const {
-    if (packetLatencies.empty()) {
+    if (packetLatencyStats.empty()) {
         if (isMeasurementPhase) {
             return -1.0;
         }
         
-        if (!latencies.empty()) {
+        if (!latencyStats.empty()) {
             return getAverageLatency();
         }
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (double latency : packetLatencies) {
-        sum += latency;
-    }
-    return sum / packetLatencies.size();
+    return packetLatencyStats.mean();
 }
 
 double Metrics::getCurrentInjectionRate() const {
@@ -98,8 +101,28 @@ double Metrics::getCurrentInjectionRate() const {
 }
 
 double Metrics::getAverageHopCount() const {
-    if (hopCounts.empty()) return 0.0;
-    return static_cast<double>(totalHops) / hopCounts.size();
+    return hopCountStats.mean();
+}
+
+double Metrics::getLatencyPercentile(double fraction) const {
+    if (packetLatencyStats.empty()) {
+        return 0.0;
+    }
+    // A bucket midpoint can lie outside the observed range; clamp to it
+    double value = packetLatencyHistogram.percentile(fraction);
+    return std::min(std::max(value, packetLatencyStats.min()), packetLatencyStats.max());
+}
+
+double Metrics::getLatencyStdDev() const {
+    return packetLatencyStats.stddev();
+}
+
+const LatencyHistogram& Metrics::getLatencyHistogram() const {
+    return packetLatencyHistogram;
+}
+
+const HopHistogram& Metrics::getHopHistogram() const {
+    return hopHistogram;
 }
 
 void Metrics::startWarmup() {
@@ -111,9 +134,14 @@ void Metrics::startWarmup() {
 void Metrics::startMeasurement() {
     isMeasurementPhase = true;
     isWarmupPhase = false;
-    packetLatencies.clear();
-    flitThroughputs.clear();
-    throughputSamples.clear();
+    packetLatencyStats.clear();
+    packetLatencyHistogram.clear();
+    flitThroughputStats.clear();
+    packetLatencySamples.clear();
+    flitThroughputSamples.clear();
+    lastThroughputSample = 0.0;
+    previousThroughputSample = 0.0;
+    throughputSampleCount = 0;
 }
 
 void Metrics::endMeasurement() {
@@ -137,13 +165,12 @@ bool Metrics::isSaturated(double latencyThreshold, double throughputDropThreshol
         return true;
     }
     
-    if (throughputSamples.size() < 2) {
+    if (throughputSampleCount < 2) {
         return false;
     }
     
-    size_t n = throughputSamples.size();
-    double currentThroughput = throughputSamples[n-1];
-    double previousThroughput = throughputSamples[n-2];
+    double currentThroughput = lastThroughputSample;
+    double previousThroughput = previousThroughputSample;
     
     if (currentThroughput == 0.0) {
         return true;
@@ -161,28 +188,36 @@ void Metrics::setSaturated(bool saturated) {
     this->saturated = saturated;
 }
 
+void Metrics::setSampleRecording(bool enabled) {
+    recordSamples = enabled;
+}
+
 void Metrics::exportToCSV(const std::string& filename) const {
+    if (!recordSamples) {
+        throw std::logic_error("Metrics::exportToCSV needs setSampleRecording(true) before the run");
+    }
     std::ofstream file(filename);
     file << "Cycle,PacketLatency,FlitThroughput,InjectionRate\n";
     
-    size_t maxSize = std::max({packetLatencies.size(), flitThroughputs.size(), injectionRates.size()});
+    size_t maxSize = std::max({packetLatencySamples.size(), flitThroughputSamples.size(),
+                               injectionRateSamples.size()});
     for (size_t i = 0; i < maxSize; ++i) {
         file << i;
         
-        if (i < packetLatencies.size()) {
-            file << "," << packetLatencies[i];
+        if (i < packetLatencySamples.size()) {
+            file << "," << packetLatencySamples[i];
         } else {
             file << ",";
         }
         
-        if (i < flitThroughputs.size()) {
-            file << "," << flitThroughputs[i];
+        if (i < flitThroughputSamples.size()) {
+            file << "," << flitThroughputSamples[i];
         } else {
             file << ",";
         }
         
-        if (i < injectionRates.size()) {
-            file << "," << injectionRates[i];
+        if (i < injectionRateSamples.size()) {
+            file << "," << injectionRateSamples[i];
         } else {
             file << ",";
         }
@@ -192,6 +227,22 @@ void Metrics::exportToCSV(const std::string& filename) const {
     file.close();
 }
 
+void Metrics::exportLatencyHistogramCSV(const std::string& filename) const {
+    std::ofstream file(filename);
+    file << "LatencyLow,LatencyHigh,Packets\n";
+    
+    for (size_t bucket = 0; bucket < packetLatencyHistogram.bucketCount(); ++bucket) {
+        uint64_t packets = packetLatencyHistogram.bucketSamples(bucket);
+        if (packets == 0) {
+            continue;
+        }
+        file << packetLatencyHistogram.bucketLowerBound(bucket) << ","
+             << packetLatencyHistogram.bucketUpperBound(bucket) << ","
+             << packets << "\n";
+    }
+    file.close();
+}
+
 void Metrics::printCurrentMetrics() const {
     std::cout << "Current Metrics:" << std::endl;
     std::cout << "  Average Packet Delay: " << getAveragePacketDelay() << " cycles" << std::endl;
@@ -203,13 +254,14 @@ void Metrics::printFinalResults() const {
     std::cout << "\n=== Final Simulation Results ===" << std::endl;
     std::cout << "Average Packet Delay: " << getAveragePacketDelay() << " cycles" << std::endl;
     std::cout << "Average Throughput: " << getThroughput() << " flits/cycle/node" << std::endl;
-    std::cout << "Total Packets: " << packetLatencies.size() << std::endl;
+    std::cout << "Total Packets: " << packetLatencyStats.count() << std::endl;
     std::cout << "Measurement Cycles: " << measurementCycles << std::endl;
     
-    if (packetLatencies.size() > 0) {
-        double minLatency = *std::min_element(packetLatencies.begin(), packetLatencies.end());
-        double maxLatency = *std::max_element(packetLatencies.begin(), packetLatencies.end());
-        std::cout << "Latency Range: " << minLatency << " - " << maxLatency << " cycles" << std::endl;
+    if (!packetLatencyStats.empty()) {
+        std::cout << "Latency Range: " << packetLatencyStats.min() << " - " << packetLatencyStats.max() << " cycles" << std::endl;
+        std::cout << "Latency Std Dev: " << getLatencyStdDev() << " cycles" << std::endl;
+        std::cout << "Latency p50/p99/p99.9: " << getLatencyPercentile(0.5) << " / "
+                  << getLatencyPercentile(0.99) << " / " << getLatencyPercentile(0.999) << " cycles" << std::endl;
     }
 }
 
@@ -219,22 +271,23 @@ void Metrics::printMetrics() const {
 }
 
 void Metrics::reset() {
-    latencies.clear();
-    throughputs.clear();
-    packetLatencies.clear();
-    flitThroughputs.clear();
-    injectionRates.clear();
-    historyLatencyThroughput.clear();
-    throughputSamples.clear();
-    hopCounts.clear();
-    networkUtilizations.clear();
+    latencyStats.clear();
+    throughputStats.clear();
+    packetLatencyStats.clear();
+    packetLatencyHistogram.clear();
+    flitThroughputStats.clear();
+    hopCountStats.clear();
+    hopHistogram.clear();
+    networkUtilizationStats.clear();
+    packetLatencySamples.clear();
+    flitThroughputSamples.clear();
+    injectionRateSamples.clear();
+    lastThroughputSample = 0.0;
+    previousThroughputSample = 0.0;
+    throughputSampleCount = 0;
     
-    totalLatency = 0.0;
-    totalThroughput = 0.0;
     totalFlits = 0.0;
     totalPackets = 0;
-    totalHops = 0;
-    count = 0;
     measurementCycles = 0;
     currentInjectionRate = 0.0;
     currentCycle = 0;
@@ -253,23 +306,27 @@ void Metrics::recordCongestionEvent() {
     congestionEvents++;
 }
 
-void Metrics::recordNetworkUtilization(double utilization) {
-    networkUtilizations.push_back(utilization);
+void Metrics::mergePacketStatistics(const Metrics& other) {
+    packetLatencyStats.merge(other.packetLatencyStats);
+    packetLatencyHistogram.merge(other.packetLatencyHistogram);
+    if (recordSamples) {
+        packetLatencySamples.insert(packetLatencySamples.end(), other.packetLatencySamples.begin(),
+                                    other.packetLatencySamples.end());
+    }
+    latencyStats.merge(other.latencyStats);
+    hopCountStats.merge(other.hopCountStats);
+    hopHistogram.merge(other.hopHistogram);
+    congestionEvents += other.congestionEvents;
 }
 
-double Metrics::getAverageNetworkUtilization() const {
-    if (networkUtilizations.empty()) return 0.0;
-    double sum = 0.0;
-    for (double util : networkUtilizations) {
-        sum += util;
-    }
-    return sum / networkUtilizations.size();
+void Metrics::recordNetworkUtilization(double utilization) {
+    networkUtilizationStats.add(utilization);
 }
 
-const std::vector<double>& Metrics::getPacketLatencies() const {
-    return packetLatencies;
+double Metrics::getAverageNetworkUtilization() const {
+    return networkUtilizationStats.mean();
 }
 
 size_t Metrics::getPacketCount() const {
-    return packetLatencies.size();
+    return packetLatencyStats.count();
 }
\ No newline at end of file
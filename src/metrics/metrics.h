@@ -10,6 +10,7 @@
 #ifndef METRICS_H
 #define METRICS_H
 
+#include "metrics/streaming_stats.h"
 #include <vector>
 #include <string>
 #include <fstream>
@@ -30,6 +31,9 @@ public:
     void recordNetworkUtilization(double utilization);
     void recordCongestionEvent();
 
+    // Fold in per-packet statistics (latency, hops, congestion) of another collector
+    void mergePacketStatistics(const Metrics& other);
+
     // Calculate metrics
     double getAveragePacketDelay() const;
     double getThroughput() const;
@@ -41,6 +45,12 @@ public:
     double getAverageNetworkUtilization() const;
     int getCongestionEvents() const;
 
+    // Latency distribution of the current measurement window
+    double getLatencyPercentile(double fraction) const;
+    double getLatencyStdDev() const;
+    const LatencyHistogram& getLatencyHistogram() const;
+    const HopHistogram& getHopHistogram() const;
+
     // Experiment control
     void startWarmup();
     void startMeasurement();
@@ -52,18 +62,24 @@ public:
     bool isSaturated(double latencyThreshold, double throughputDropThreshold) const;
     void setSaturated(bool saturated);
     
+    // Keep every latency, throughput and injection-rate sample for exportToCSV.
+    // Off by default, so memory stays constant however long the run is.
+    void setSampleRecording(bool enabled);
+
+    // Cycle,PacketLatency,FlitThroughput,InjectionRate rows of the recorded samples;
+    // throws std::logic_error unless sample recording was on
     void exportToCSV(const std::string& filename) const;
+    // LatencyLow,LatencyHigh,Packets rows of the non-empty latency histogram buckets
+    void exportLatencyHistogramCSV(const std::string& filename) const;
     void printCurrentMetrics() const;
     void printFinalResults() const;
     void printMetrics() const;
 
-    const std::vector<double>& getPacketLatencies() const;
     size_t getPacketCount() const;
 
 private:
-    double totalLatency;
-    double totalThroughput;
-    int count;
+    void recordThroughputSample(double throughput);
+
     int totalPackets;
     double totalFlits;
     int measurementCycles;
@@ -73,18 +89,27 @@ private:
     int currentCycle;
     bool saturated;
     
-    std::vector<double> packetLatencies;
-    std::vector<double> latencies;
-    std::vector<double> flitThroughputs;
-    std::vector<double> throughputs;
-    std::vector<double> injectionRates;
-    std::vector<double> throughputSamples;
-    std::vector<double> networkUtilizations;
+    // Streaming summaries: memory stays constant however long the run is
+    RunningStats packetLatencyStats;
+    LatencyHistogram packetLatencyHistogram;
+    RunningStats latencyStats;
+    RunningStats flitThroughputStats;
+    RunningStats throughputStats;
+    RunningStats networkUtilizationStats;
+    RunningStats hopCountStats;
+    HopHistogram hopHistogram;
+
+    // Raw samples, kept only with setSampleRecording(true)
+    bool recordSamples;
+    std::vector<double> packetLatencySamples;
+    std::vector<double> flitThroughputSamples;
+    std::vector<double> injectionRateSamples;
 
-    std::vector<std::pair<double, double>> historyLatencyThroughput;
+    // Saturation detection only compares the two most recent samples
+    double lastThroughputSample;
+    double previousThroughputSample;
+    size_t throughputSampleCount;
 
-    std::vector<int> hopCounts;
-    int totalHops;
     int congestionEvents;
 };
 
@@ -0,0 +1,112 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "metrics/streaming_stats.h"
+#include <cmath>
+
+const int HopHistogram::kMaxTrackedHops;
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+
+    size_t count = count_ + other.count_;
+    double delta = other.welfordMean_ - welfordMean_;
+    double weight = static_cast<double>(other.count_) / static_cast<double>(count);
+    welfordMean_ += delta * weight;
+    m2_ += other.m2_ + delta * delta * static_cast<double>(count_) * weight;
+    sum_ += other.sum_;
+    if (other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+    count_ = count;
+}
+
+double RunningStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalf, 0), total_(0) {
+}
+
+void LatencyHistogram::clear() {
+    counts_.assign(counts_.size(), 0);
+    total_ = 0;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+}
+
+uint64_t LatencyHistogram::toTicks(double latency) {
+    const double maxTicks = static_cast<double>((uint64_t(1) << kMaxValueBits) - 1);
+    double ticks = latency * kTicksPerCycle;
+    if (!(ticks > 0.0)) {
+        return 0;
+    }
+    return ticks >= maxTicks ? static_cast<uint64_t>(maxTicks) : static_cast<uint64_t>(ticks);
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t ticks) {
+    if (ticks < kSubBucketCount) {
+        return static_cast<size_t>(ticks);
+    }
+    // Keep the top kSubBucketBits bits: ticks >> shift lands in [half, count)
+    int shift = (63 - __builtin_clzll(ticks)) - (kSubBucketBits - 1);
+    return static_cast<size_t>(kSubBucketCount + (shift - 1) * kSubBucketHalf + ((ticks >> shift) - kSubBucketHalf));
+}
+
+uint64_t LatencyHistogram::bucketLowTicks(size_t bucket) {
+    if (bucket < kSubBucketCount) {
+        return bucket;
+    }
+    size_t offset = bucket - kSubBucketCount;
+    int shift = static_cast<int>(offset / kSubBucketHalf) + 1;
+    uint64_t subBucket = offset % kSubBucketHalf + kSubBucketHalf;
+    return subBucket << shift;
+}
+
+double LatencyHistogram::bucketLowerBound(size_t bucket) const {
+    return static_cast<double>(bucketLowTicks(bucket)) / kTicksPerCycle;
+}
+
+double LatencyHistogram::bucketUpperBound(size_t bucket) const {
+    if (bucket + 1 < counts_.size()) {
+        return static_cast<double>(bucketLowTicks(bucket + 1)) / kTicksPerCycle;
+    }
+    return static_cast<double>(uint64_t(1) << kMaxValueBits) / kTicksPerCycle;
+}
+
+double LatencyHistogram::percentile(double fraction) const {
+    if (total_ == 0) {
+        return 0.0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total_)));
+    if (rank < 1) rank = 1;
+    if (rank > total_) rank = total_;
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+        seen += counts_[bucket];
+        if (seen >= rank) {
+            double low = bucketLowerBound(bucket);
+            double high = bucketUpperBound(bucket) - 1.0 / kTicksPerCycle;
+            return (low + high) / 2.0;
+        }
+    }
+    return bucketLowerBound(counts_.size() - 1);
+}
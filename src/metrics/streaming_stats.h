@@ -0,0 +1,155 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Count, sum, extrema and Welford variance of a sample stream
+ *
+ * mean() divides the exact running sum rather than returning Welford's
+ * running mean, so averages match a plain sum over the samples.
+ */
+class RunningStats {
+public:
+    RunningStats() { clear(); }
+
+    void add(double value) {
+        count_++;
+        sum_ += value;
+        double delta = value - welfordMean_;
+        welfordMean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (value - welfordMean_);
+        if (count_ == 1 || value < min_) min_ = value;
+        if (count_ == 1 || value > max_) max_ = value;
+    }
+
+    /**
+     * @brief Fold in another stream's samples (Chan et al. pairwise update)
+     */
+    void merge(const RunningStats& other);
+
+    void clear() {
+        count_ = 0;
+        sum_ = 0.0;
+        welfordMean_ = 0.0;
+        m2_ = 0.0;
+        min_ = 0.0;
+        max_ = 0.0;
+    }
+
+    bool empty() const { return count_ == 0; }
+    size_t count() const { return count_; }
+    double sum() const { return sum_; }
+    double mean() const { return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+
+    /**
+     * @brief Sample variance (n - 1 denominator)
+     */
+    double variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+    double stddev() const;
+
+private:
+    size_t count_;
+    double sum_;
+    double welfordMean_;
+    double m2_;
+    double min_;
+    double max_;
+};
+
+/**
+ * @brief Log-linear (HDR-style) histogram of non-negative latencies
+ *
+ * Values are quantized to 1/16 cycle. The first 256 buckets cover
+ * [0, 16) cycles exactly; above that every power-of-two range is split
+ * into 128 equal buckets, so any bucket is narrower than 1/128 of the
+ * values it holds. Storage is fixed at construction and percentile
+ * queries walk the buckets once.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(double latency) {
+        counts_[bucketIndex(toTicks(latency))]++;
+        total_++;
+    }
+
+    void clear();
+    void merge(const LatencyHistogram& other);
+
+    size_t count() const { return total_; }
+
+    /**
+     * @brief Value below which the given fraction of samples falls
+     *
+     * Returns the midpoint of the bucket holding that rank, so the error
+     * is bounded by half a bucket width. fraction is in [0, 1].
+     */
+    double percentile(double fraction) const;
+
+    size_t bucketCount() const { return counts_.size(); }
+    uint64_t bucketSamples(size_t bucket) const { return counts_[bucket]; }
+    double bucketLowerBound(size_t bucket) const;
+    double bucketUpperBound(size_t bucket) const;
+
+private:
+    static const int kTicksPerCycle = 16;
+    static const int kSubBucketBits = 8;
+    static const uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+    static const uint64_t kSubBucketHalf = kSubBucketCount / 2;
+    static const int kMaxValueBits = 32;
+
+    static uint64_t toTicks(double latency);
+    static size_t bucketIndex(uint64_t ticks);
+    static uint64_t bucketLowTicks(size_t bucket);
+
+    std::vector<uint64_t> counts_;
+    size_t total_;
+};
+
+/**
+ * @brief Exact counts of path lengths up to a fixed hop limit
+ *
+ * Paths longer than kMaxTrackedHops share the last bucket.
+ */
+class HopHistogram {
+public:
+    static const int kMaxTrackedHops = 63;
+
+    HopHistogram() : counts_(kMaxTrackedHops + 1, 0) {}
+
+    void record(int hops) {
+        if (hops < 0) hops = 0;
+        counts_[hops < kMaxTrackedHops ? hops : kMaxTrackedHops]++;
+    }
+
+    void clear() { counts_.assign(counts_.size(), 0); }
+
+    void merge(const HopHistogram& other) {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+    }
+
+    uint64_t packetsWithHops(int hops) const {
+        return (hops >= 0 && hops <= kMaxTrackedHops) ? counts_[hops] : 0;
+    }
+
+private:
+    std::vector<uint64_t> counts_;
+};
+
+#endif // STREAMING_STATS_H
@@ -0,0 +1,48 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef HYPERCUBE_KERNEL_H
+#define HYPERCUBE_KERNEL_H
+
+#include <cstdint>
+
+/**
+ * @brief Hypercube addressing and E-cube routing on integer node ids
+ *
+ * Bit i of a node id is its coordinate in dimension i. The dimensions two
+ * nodes differ in are the set bits of a ^ b, their distance is its
+ * popcount, and E-cube corrects the lowest set bit first. Every query is
+ * a handful of integer instructions with no allocation.
+ */
+struct HypercubeKernel {
+    static uint32_t differingDimensions(int a, int b) {
+        return static_cast<uint32_t>(a ^ b);
+    }
+
+    static int hammingDistance(int a, int b) {
+        return __builtin_popcount(differingDimensions(a, b));
+    }
+
+    static bool differsInDimension(int a, int b, int dim) {
+        return (differingDimensions(a, b) >> dim) & 1u;
+    }
+
+    static int neighborInDimension(int node, int dim) {
+        return node ^ (1 << dim);
+    }
+
+    /**
+     * @brief Lowest dimension in which a and b differ, or -1 if equal
+     */
+    static int lowestDifferingDimension(int a, int b) {
+        uint32_t diff = differingDimensions(a, b);
+        return diff ? __builtin_ctz(diff) : -1;
+    }
+};
+
+#endif // HYPERCUBE_KERNEL_H
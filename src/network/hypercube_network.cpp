@@ -8,54 +8,109 @@
 
 #include "network/hypercube_network.h"
 #include "network/hypercube_node.h"
+#include "network/hypercube_kernel.h"
 #include "network/link.h"  // Ensure this header is included to use Direction enum
-#include <cmath>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
-HypercubeNetwork::HypercubeNetwork(int dimension) : Network(0, 0), dimension(dimension) {
-    totalNodes = static_cast<int>(std::pow(2, dimension));
+HypercubeNetwork::HypercubeNetwork(int dimension, bool implicitTopology, const TopologyBuildOptions& options)
+    : Network(0, 0, options), dimension(dimension), implicitTopology(implicitTopology),
+      hypercubeNodes(nullptr), neighborTables(nullptr) {
+    if (dimension < 1 || dimension > kMaxDimension) {
+        throw std::invalid_argument("Hypercube dimension must be between 1 and " +
+                                    std::to_string(kMaxDimension));
+    }
+    totalNodes = 1 << dimension;
 }
 
 void HypercubeNetwork::initializeTopology() {
+    if (implicitTopology || hypercubeNodes) {
+        return;
+    }
+
+    size_t slots = static_cast<size_t>(totalNodes) * dimension;
+    linkCount = static_cast<int>(slots / 2);
+    arena.reserve(TopologyArena::bytesFor<HypercubeNode>(totalNodes) +
+                  TopologyArena::bytesFor<HypercubeNode*>(slots) +
+                  TopologyArena::bytesFor<Link>(linkCount) +
+                  TopologyArena::bytesFor<Link*>(slots) +
+                  queueSlabBytes(totalNodes),
+                  buildOptions.hugePages);
+
     createHypercubeNodes();
     createHypercubeLinks();
 }
 
 void HypercubeNetwork::createHypercubeNodes() {
-    hypercubeNodes.clear();
-    hypercubeNodes.reserve(totalNodes);
-    
-    for (int nodeId = 0; nodeId < totalNodes; ++nodeId) {
-        std::vector<int> coordinates = getCoordinates(nodeId);
-        HypercubeNode* node = new HypercubeNode(nodeId, coordinates, dimension);
-        hypercubeNodes.push_back(node);
-    }
+    hypercubeNodes = arena.allocate<HypercubeNode>(totalNodes);
+    neighborTables = arena.allocate<HypercubeNode*>(static_cast<size_t>(totalNodes) * dimension);
+    allocateQueueSlab(totalNodes);
+
+    buildInParallel(totalNodes, buildOptions.threads, [this](int begin, int end) {
+        for (int nodeId = begin; nodeId < end; ++nodeId) {
+            HypercubeNode* node = new (&hypercubeNodes[nodeId])
+                HypercubeNode(nodeId, dimension, neighborTables + static_cast<size_t>(nodeId) * dimension);
+            for (int dim = 0; dim < dimension; ++dim) {
+                node->setNeighbor(dim, &hypercubeNodes[HypercubeKernel::neighborInDimension(nodeId, dim)]);
+            }
+            attachQueues(*node, nodeId);
+        }
+    });
 }
 
 void HypercubeNetwork::createHypercubeLinks() {
+    links = arena.allocate<Link>(linkCount);
+    adjacency = arena.allocate<Link*>(static_cast<size_t>(totalNodes) * dimension);
+
+    // Each link is created by its lower endpoint, one per dimension in which that id has a 0 bit
+    std::vector<int> firstLink(totalNodes + 1, 0);
     for (int nodeId = 0; nodeId < totalNodes; ++nodeId) {
-        HypercubeNode* currentNode = hypercubeNodes[nodeId];
-        
-        for (int dim = 0; dim < dimension; ++dim) {
-            int neighborId = nodeId ^ (1 << dim); // Flip the dim-th bit
-            if (neighborId > nodeId) { // Avoid duplicate link creation
-                HypercubeNode* neighborNode = hypercubeNodes[neighborId];
-                
-                Direction linkDirection;
-                switch (dim % 4) {
-                    case 0: linkDirection = Direction::POSITIVE_X; break;
-                    case 1: linkDirection = Direction::POSITIVE_Y; break;
-                    case 2: linkDirection = Direction::NEGATIVE_X; break;
-                    case 3: linkDirection = Direction::NEGATIVE_Y; break;
-                    default: linkDirection = Direction::POSITIVE_X; break;
+        firstLink[nodeId + 1] = firstLink[nodeId] + dimension - __builtin_popcount(nodeId);
+    }
+    auto linkIndex = [&firstLink](int lowerId, int dim) {
+        return firstLink[lowerId] + dim - __builtin_popcount(lowerId & ((1 << dim) - 1));
+    };
+
+    buildInParallel(totalNodes, buildOptions.threads, [&](int begin, int end) {
+        for (int nodeId = begin; nodeId < end; ++nodeId) {
+            for (int dim = 0; dim < dimension; ++dim) {
+                int neighborId = HypercubeKernel::neighborInDimension(nodeId, dim);
+                if (neighborId > nodeId) { // Avoid duplicate link creation
+                    Direction linkDirection;
+                    switch (dim % 4) {
+                        case 0: linkDirection = Direction::POSITIVE_X; break;
+                        case 1: linkDirection = Direction::POSITIVE_Y; break;
+                        case 2: linkDirection = Direction::NEGATIVE_X; break;
+                        case 3: linkDirection = Direction::NEGATIVE_Y; break;
+                        default: linkDirection = Direction::POSITIVE_X; break;
+                    }
+                    new (&links[linkIndex(nodeId, dim)])
+                        Link(&hypercubeNodes[nodeId], &hypercubeNodes[neighborId], linkDirection);
                 }
-                
-                Link* link = new Link(currentNode, neighborNode, linkDirection);
-                links.push_back(link);
-                currentNode->addLink(link);
-                neighborNode->addLink(link);
             }
         }
-    }
+    });
+
+    // Creation order per node: links from lower neighbors (highest dimension first), then its own
+    buildInParallel(totalNodes, buildOptions.threads, [&](int begin, int end) {
+        for (int nodeId = begin; nodeId < end; ++nodeId) {
+            Link** first = adjacency + static_cast<size_t>(nodeId) * dimension;
+            Link** slot = first;
+            for (int dim = dimension - 1; dim >= 0; --dim) {
+                if (nodeId & (1 << dim)) {
+                    *slot++ = &links[linkIndex(HypercubeKernel::neighborInDimension(nodeId, dim), dim)];
+                }
+            }
+            for (int dim = 0; dim < dimension; ++dim) {
+                if (!(nodeId & (1 << dim))) {
+                    *slot++ = &links[linkIndex(nodeId, dim)];
+                }
+            }
+            hypercubeNodes[nodeId].setLinks(first, dimension);
+        }
+    });
 }
 
 std::vector<int> HypercubeNetwork::getCoordinates(int nodeId) const {
@@ -77,41 +132,39 @@ int HypercubeNetwork::getNodeId(const std::vector<int>& coordinates) const {
 }
 
 HypercubeNode* HypercubeNetwork::getHypercubeNode(int nodeId) const {
-    if (nodeId >= 0 && nodeId < totalNodes) {
-        return hypercubeNodes[nodeId];
+    if (hypercubeNodes && nodeId >= 0 && nodeId < totalNodes) {
+        return &hypercubeNodes[nodeId];
     }
     return nullptr;
 }
 
+int HypercubeNetwork::getNeighborId(int nodeId, int dim) const {
+    return HypercubeKernel::neighborInDimension(nodeId, dim);
+}
+
 bool HypercubeNetwork::areNeighbors(int node1, int node2) const {
-    int xorResult = node1 ^ node2;
-    return xorResult && !(xorResult & (xorResult - 1));
+    return HypercubeKernel::hammingDistance(node1, node2) == 1;
 }
 
 int HypercubeNetwork::getHammingDistance(int node1, int node2) const {
-    int xorResult = node1 ^ node2;
-    int distance = 0;
-    while (xorResult) {
-        distance += xorResult & 1;
-        xorResult >>= 1;
-    }
-    return distance;
+    return HypercubeKernel::hammingDistance(node1, node2);
 }
 
 Node* HypercubeNetwork::getNode(int x, int y) {
     // Map 2D coordinates to hypercube node ID
     if (dimension >= 2) {
         int nodeId = x + y * (1 << (dimension/2));
-        if (nodeId < totalNodes) {
-            return hypercubeNodes[nodeId];
+        if (hypercubeNodes && nodeId < totalNodes) {
+            return &hypercubeNodes[nodeId];
         }
     }
     return nullptr;
 }
 
 HypercubeNetwork::~HypercubeNetwork() {
-    for (HypercubeNode* node : hypercubeNodes) {
-        delete node;
+    if (hypercubeNodes) {
+        for (int nodeId = 0; nodeId < totalNodes; ++nodeId) {
+            hypercubeNodes[nodeId].~HypercubeNode();
+        }
     }
-    hypercubeNodes.clear();
-}
\ No newline at end of file
+}
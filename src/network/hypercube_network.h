@@ -14,14 +14,36 @@
 
 class HypercubeNode; // Forward declaration
 
+/**
+ * @brief Hypercube network of 2^dimension nodes
+ *
+ * By default every vertex gets a HypercubeNode and every edge a Link. In
+ * implicit mode no objects are built: node ids, neighbors (id ^ (1 << d))
+ * and link indices (id * dimension + d) are computed on demand, and the
+ * simulation engines keep router state in their own dense arrays. Node
+ * lookups then return nullptr, so object-based routing calls fail.
+ *
+ * Built objects live in the network's TopologyArena like mesh nodes do;
+ * every node has exactly dimension links and neighbors, so both tables
+ * are dense arrays indexed by id * dimension.
+ */
 class HypercubeNetwork : public Network {
 private:
     int dimension;
     int totalNodes;
-    std::vector<HypercubeNode*> hypercubeNodes;
+    bool implicitTopology;
+    HypercubeNode* hypercubeNodes;
+    HypercubeNode** neighborTables;
     
 public:
-    HypercubeNetwork(int dimension);
+    // Largest cube whose directed link indices fit in an int with room to spare
+    static const int kMaxDimension = 24;
+
+    /**
+     * @throws std::invalid_argument if dimension is outside 1..kMaxDimension
+     */
+    HypercubeNetwork(int dimension, bool implicitTopology = false,
+                     const TopologyBuildOptions& options = TopologyBuildOptions());
     ~HypercubeNetwork();
     
     void initializeTopology() override;
@@ -29,10 +51,18 @@ public:
     
     int getDimension() const { return dimension; }
     int getTotalNodes() const { return totalNodes; }
+    bool isImplicit() const { return implicitTopology; }
+    
+    /**
+     * @brief Directed links, one per (node, dimension)
+     */
+    int getLinkCount() const { return totalNodes * dimension; }
+    int getLinkIndex(int nodeId, int dim) const { return nodeId * dimension + dim; }
     HypercubeNode* getHypercubeNode(int nodeId) const;
     
     int getNodeId(const std::vector<int>& coordinates) const;
     std::vector<int> getCoordinates(int nodeId) const;
+    int getNeighborId(int nodeId, int dim) const;
     bool areNeighbors(int node1, int node2) const;
     int getHammingDistance(int node1, int node2) const;
     
@@ -7,13 +7,19 @@
  */
 
 #include "network/hypercube_node.h"
-#include "network/link.h"
+#include "network/hypercube_kernel.h"
+#include <algorithm>
 
-HypercubeNode::HypercubeNode(int id, const std::vector<int>& coords, int dim) 
-    : Node(id), coordinates(coords), dimension(dim) {
+HypercubeNode::HypercubeNode(int id, int dim, HypercubeNode** neighborTable)
+    : Node(id), dimension(dim), neighbors(neighborTable) {
+    std::fill(neighbors, neighbors + dimension, nullptr);
 }
 
-const std::vector<int>& HypercubeNode::getCoordinates() const {
+std::vector<int> HypercubeNode::getCoordinates() const {
+    std::vector<int> coordinates(dimension);
+    for (int i = 0; i < dimension; ++i) {
+        coordinates[i] = (getId() >> i) & 1;
+    }
     return coordinates;
 }
 
@@ -21,56 +27,22 @@ int HypercubeNode::getDimension() const {
     return dimension;
 }
 
+void HypercubeNode::setNeighbor(int dim, HypercubeNode* neighbor) {
+    if (dim >= 0 && dim < dimension) {
+        neighbors[dim] = neighbor;
+    }
+}
+
 HypercubeNode* HypercubeNode::getNeighborInDimension(int dim) const {
     if (dim < 0 || dim >= dimension) {
         return nullptr;
     }
-    
-    for (Link* link : getLinks()) {
-        if (!link) continue;
-        
-        Node* otherNode = nullptr;
-        if (link->getSourceNode() == this) {
-            otherNode = link->getDestinationNode();
-        } else if (link->getDestinationNode() == this) {
-            otherNode = link->getSourceNode();
-        }
-        
-        if (!otherNode) continue;
-        
-        HypercubeNode* otherHyperNode = dynamic_cast<HypercubeNode*>(otherNode);
-        if (!otherHyperNode) continue;
-        
-        if (isNeighborInDimension(otherHyperNode, dim)) {
-            return otherHyperNode;
-        }
-    }
-    
-    return nullptr;
+    return neighbors[dim];
 }
 
 bool HypercubeNode::isNeighborInDimension(const HypercubeNode* other, int dim) const {
     if (!other || dim < 0 || dim >= dimension) {
         return false;
     }
-    
-    const auto& otherCoords = other->getCoordinates();
-    
-    if (coordinates.size() != otherCoords.size()) {
-        return false;
-    }
-    
-    for (int i = 0; i < dimension; ++i) {
-        if (i == dim) {
-            if (coordinates[i] == otherCoords[i]) {
-                return false;
-            }
-        } else {
-            if (coordinates[i] != otherCoords[i]) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
-}
\ No newline at end of file
+    return HypercubeKernel::differingDimensions(getId(), other->getId()) == (1u << dim);
+}
@@ -12,17 +12,28 @@
 #include "node.h"
 #include <vector>
 
+/**
+ * @brief Hypercube router addressed by its node id
+ *
+ * Bit i of the id is the node's coordinate in dimension i; neighbors are
+ * kept in a table indexed by dimension, filled in as links are created.
+ * The table is a slice of the network's neighbor array.
+ */
 class HypercubeNode : public Node {
 private:
-    std::vector<int> coordinates;
     int dimension;
+    HypercubeNode** neighbors;
     
 public:
-    HypercubeNode(int id, const std::vector<int>& coords, int dim);
+    /**
+     * @param neighborTable dim entries owned by the network
+     */
+    HypercubeNode(int id, int dim, HypercubeNode** neighborTable);
     
-    const std::vector<int>& getCoordinates() const;
+    std::vector<int> getCoordinates() const;
     int getDimension() const;
     
+    void setNeighbor(int dim, HypercubeNode* neighbor);
     HypercubeNode* getNeighborInDimension(int dim) const;
     bool isNeighborInDimension(const HypercubeNode* other, int dim) const;
 };
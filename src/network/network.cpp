@@ -1,9 +1,23 @@
 #include "network/network.h"
 #include "network/node.h"
 #include "network/link.h"
+#include "network/ring_queue.h"
+#include <new>
 #include <vector>
 
-Network::Network(int width, int height) : width(width), height(height) {
+Network::Network(int width, int height, const TopologyBuildOptions& options)
+    : width(width), height(height), buildOptions(options),
+      nodes(nullptr), links(nullptr), linkCount(0), adjacency(nullptr),
+      queueCapacity(RingQueue<Packet*>::capacityFor(options.queueDepth)),
+      arrivedSlots(nullptr), channelSlots(nullptr) {
+    if (width > 0 && height > 0) {
+        linkCount = (width - 1) * height + width * (height - 1);
+        arena.reserve(TopologyArena::bytesFor<Node>(static_cast<size_t>(width) * height) +
+                      TopologyArena::bytesFor<Link>(linkCount) +
+                      TopologyArena::bytesFor<Link*>(2 * static_cast<size_t>(linkCount)) +
+                      queueSlabBytes(static_cast<size_t>(width) * height),
+                      options.hugePages);
+    }
     createNodes();
     createLinks();
 }
@@ -12,58 +26,118 @@ void Network::initializeTopology() {
 }
 
 void Network::createNodes() {
-    nodes.resize(height);
-    for (int y = 0; y < height; ++y) {
-        nodes[y].resize(width);
-        for (int x = 0; x < width; ++x) {
-            Node* node = new Node(x, y);
-            nodes[y][x] = node;
-        }
+    if (width <= 0 || height <= 0) {
+        return;
     }
+    nodes = arena.allocate<Node>(static_cast<size_t>(width) * height);
+    allocateQueueSlab(static_cast<size_t>(width) * height);
+    buildInParallel(width * height, buildOptions.threads, [this](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            new (&nodes[index]) Node(index % width, index / width);
+            attachQueues(nodes[index], index);
+        }
+    });
+}
+
+size_t Network::queueSlabBytes(size_t nodeCount) const {
+    return TopologyArena::bytesFor<Packet*>(nodeCount * queueCapacity) +
+           TopologyArena::bytesFor<Message*>(2 * nodeCount * queueCapacity);
+}
+
+void Network::allocateQueueSlab(size_t nodeCount) {
+    arrivedSlots = arena.allocate<Packet*>(nodeCount * queueCapacity);
+    channelSlots = arena.allocate<Message*>(2 * nodeCount * queueCapacity);
+}
+
+void Network::attachQueues(Node& node, size_t index) {
+    node.attachQueues(arrivedSlots + index * queueCapacity,
+                      channelSlots + 2 * index * queueCapacity, queueCapacity);
 }
 
 void Network::createLinks() {
-    for (int i = 0; i < width; ++i) {
-        for (int j = 0; j < height; ++j) {
-            Node* currentNode = getNode(i, j);
-            
-            if (i < width - 1) {
-                Node* rightNode = getNode(i + 1, j);
-                Link* linkPositiveX = new Link(currentNode, rightNode, Direction::POSITIVE_X);
-                links.push_back(linkPositiveX);
-                currentNode->addLink(linkPositiveX);
-                rightNode->addLink(linkPositiveX);
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    int nodeCount = width * height;
+    links = arena.allocate<Link>(linkCount);
+    adjacency = arena.allocate<Link*>(2 * static_cast<size_t>(linkCount));
+
+    // Links are numbered column by column (x, then y): each node's +X link, then its +Y link
+    std::vector<int> firstLink(nodeCount + 1, 0);
+    for (int column = 0; column < nodeCount; ++column) {
+        int x = column / height;
+        int y = column % height;
+        firstLink[column + 1] = firstLink[column] + (x < width - 1) + (y < height - 1);
+    }
+    std::vector<int> firstSlot(nodeCount + 1, 0);
+    for (int index = 0; index < nodeCount; ++index) {
+        int x = index % width;
+        int y = index / width;
+        firstSlot[index + 1] = firstSlot[index] + (x > 0) + (y > 0) + (x < width - 1) + (y < height - 1);
+    }
+
+    buildInParallel(nodeCount, buildOptions.threads, [&](int begin, int end) {
+        for (int column = begin; column < end; ++column) {
+            int x = column / height;
+            int y = column % height;
+            Node* currentNode = &nodes[y * width + x];
+            int link = firstLink[column];
+            if (x < width - 1) {
+                new (&links[link++]) Link(currentNode, &nodes[y * width + x + 1], Direction::POSITIVE_X);
             }
-            
-            if (j < height - 1) {
-                Node* downNode = getNode(i, j + 1);
-                Link* linkPositiveY = new Link(currentNode, downNode, Direction::POSITIVE_Y);
-                links.push_back(linkPositiveY);
-                currentNode->addLink(linkPositiveY);
-                downNode->addLink(linkPositiveY);
+            if (y < height - 1) {
+                new (&links[link]) Link(currentNode, &nodes[(y + 1) * width + x], Direction::POSITIVE_Y);
             }
         }
-    }
+    });
+
+    // A node lists its links in creation order: from its -X neighbor, its -Y neighbor, then its own
+    buildInParallel(nodeCount, buildOptions.threads, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            int x = index % width;
+            int y = index / width;
+            Link** first = adjacency + firstSlot[index];
+            Link** slot = first;
+            if (x > 0) {
+                *slot++ = &links[firstLink[(x - 1) * height + y]];
+            }
+            if (y > 0) {
+                *slot++ = &links[firstLink[x * height + y - 1] + (x < width - 1)];
+            }
+            int own = firstLink[x * height + y];
+            if (x < width - 1) {
+                *slot++ = &links[own++];
+            }
+            if (y < height - 1) {
+                *slot++ = &links[own];
+            }
+            nodes[index].setLinks(first, static_cast<int>(slot - first));
+        }
+    });
 }
 
 Node* Network::getNode(int x, int y) {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        return nodes[y][x];
+        return &nodes[y * width + x];
     }
     return nullptr;
 }
 
 std::vector<Link*> Network::getLinks() {
-    return links;
+    std::vector<Link*> result(linkCount);
+    for (int i = 0; i < linkCount; ++i) {
+        result[i] = &links[i];
+    }
+    return result;
 }
 
 Network::~Network() {
-    for (int i = 0; i < height; ++i) {
-        for (int j = 0; j < width; ++j) {
-            delete nodes[i][j];
+    if (nodes) {
+        for (int index = 0; index < width * height; ++index) {
+            nodes[index].~Node();
         }
     }
-    for (Link* link : links) {
-        delete link;
+    for (int i = 0; i < linkCount; ++i) {
+        links[i].~Link();
     }
-}
\ No newline at end of file
+}
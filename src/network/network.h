@@ -9,28 +9,59 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include "topology_arena.h"
 #include <vector>
 
 class Node;
 class Link;
+class Packet;
+class Message;
 
+/**
+ * @brief 2D mesh of Node objects joined by Links
+ *
+ * Nodes, links and the per-node link lists are placed in one
+ * TopologyArena: nodes row by row, links in creation order, and each
+ * node's links as a slice of a shared adjacency array (CSR). The nodes'
+ * queues are fixed rings sliced from two more arrays there, sized from
+ * buffer_size; the mapping is lazy, so slots a run never touches cost no
+ * memory. Large networks are constructed on several threads.
+ */
 class Network {
 public:
-    Network(int width, int height);
+    Network(int width, int height, const TopologyBuildOptions& options = TopologyBuildOptions());
     virtual ~Network();
     
     virtual Node* getNode(int x, int y);  // Add virtual
     virtual void initializeTopology();    // Add virtual function
     std::vector<Link*> getLinks();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool isHugePageBacked() const { return arena.isHugePageBacked(); }
     
 protected:  // Change to protected for subclass access
     void createNodes();
     void createLinks();
+
+    /**
+     * @brief Arena bytes for nodeCount nodes' queue slots
+     */
+    size_t queueSlabBytes(size_t nodeCount) const;
+    void allocateQueueSlab(size_t nodeCount);
+    void attachQueues(Node& node, size_t index);
     
     int width;
     int height;
-    std::vector<std::vector<Node*>> nodes;
-    std::vector<Link*> links;  // Change to protected
+    TopologyBuildOptions buildOptions;
+    TopologyArena arena;
+    Node* nodes;          // width * height, node (x, y) at y * width + x
+    Link* links;          // Constructed in place; destroyed by ~Network
+    int linkCount;
+    Link** adjacency;     // Every node's links, node by node
+    uint32_t queueCapacity;
+    Packet** arrivedSlots;   // queueCapacity per node
+    Message** channelSlots;  // 2 * queueCapacity per node
 };
 
 #endif // NETWORK_H
\ No newline at end of file
@@ -10,17 +10,30 @@
 #include "network.h"
 #include "hypercube_network.h"
 #include "../utils/config.h"
+#include "../utils/work_stealing_pool.h"
 #include <stdexcept>
+#include <mutex>
 #include <iostream>
 
+namespace {
+
+// Large networks are constructed on every hardware thread
+TopologyBuildOptions buildOptionsFor(const Config& config) {
+    TopologyBuildOptions options;
+    options.hugePages = config.isHugePagesEnabled();
+    options.threads = WorkStealingPool::getDefaultThreadCount();
+    options.queueDepth = config.getBufferSize();
+    return options;
+}
+
+} // namespace
+
 NetworkFactory& NetworkFactory::getInstance() {
     static NetworkFactory instance;
-    static bool initialized = false;
+    static std::once_flag initialized;
     
-    if (!initialized) {
-        instance.initializeBuiltinTypes();
-        initialized = true;
-    }
+    // Sweep workers may reach the factory concurrently
+    std::call_once(initialized, [] { instance.initializeBuiltinTypes(); });
     
     return instance;
 }
@@ -76,7 +89,7 @@ void NetworkFactory::initializeBuiltinTypes() {
     // Register 2D Mesh network
     registerNetworkType("2D_mesh", [](const Config& config) -> std::unique_ptr<Network> {
         auto size = config.getNetworkSize2D();
-        auto network = std::unique_ptr<Network>(new Network(size[0], size[1]));
+        auto network = std::unique_ptr<Network>(new Network(size[0], size[1], buildOptionsFor(config)));
         network->initializeTopology();
         return network;
     });
@@ -84,7 +97,8 @@ void NetworkFactory::initializeBuiltinTypes() {
     // Register Hypercube network
     registerNetworkType("hypercube", [](const Config& config) -> std::unique_ptr<Network> {
         int dimension = config.getHypercubeDimension();
-        auto network = std::unique_ptr<Network>(new HypercubeNetwork(dimension));
+        auto network = std::unique_ptr<Network>(new HypercubeNetwork(dimension, config.isImplicitTopology(),
+                                                                          buildOptionsFor(config)));
         network->initializeTopology();
         return network;
     });
@@ -93,7 +107,7 @@ void NetworkFactory::initializeBuiltinTypes() {
     registerNetworkType("3D_mesh", [](const Config& config) -> std::unique_ptr<Network> {
         auto size = config.getNetworkSize3D();
         // For now, create a 2D network as placeholder
-        auto network = std::unique_ptr<Network>(new Network(size[0] * size[1], size[2]));
+        auto network = std::unique_ptr<Network>(new Network(size[0] * size[1], size[2], buildOptionsFor(config)));
         network->initializeTopology();
         return network;
     });
@@ -10,12 +10,11 @@
 #include "network/link.h"
 #include "message/message.h"
 #include "message/packet.h"
-#include <queue>
 
-Node::Node(int id) : id(id), x(0), y(0) {
+Node::Node(int id) : id(id), x(0), y(0), links(nullptr), linkCount(0) {
 }
 
-Node::Node(int x, int y) : id(x * 100 + y), x(x), y(y) {
+Node::Node(int x, int y) : id(x * 100 + y), x(x), y(y), links(nullptr), linkCount(0) {
 }
 
 Node::~Node() {
@@ -35,12 +34,19 @@ Node::~Node() {
     }
 }
 
-void Node::addLink(Link* link) {
-    links.push_back(link);
+void Node::setLinks(Link* const* links, int count) {
+    this->links = links;
+    linkCount = count;
 }
 
-const std::vector<Link*>& Node::getLinks() const {
-    return links;
+LinkRange Node::getLinks() const {
+    return LinkRange(links, links + linkCount);
+}
+
+void Node::attachQueues(Packet** arrivedSlots, Message** channelSlots, uint32_t capacity) {
+    arrivedPackets.attach(arrivedSlots, capacity);
+    adaptiveChannel.attach(channelSlots, capacity);
+    deterministicChannel.attach(channelSlots + capacity, capacity);
 }
 
 int Node::getX() const {
@@ -55,12 +61,11 @@ int Node::getId() const {
     return id;
 }
 
-void Node::receiveMessage(Message* message, VirtualChannel vc) {
+bool Node::receiveMessage(Message* message, VirtualChannel vc) {
     if (vc == VirtualChannel::ADAPTIVE) {
-        adaptiveChannel.push(message);
-    } else {
-        deterministicChannel.push(message);
+        return adaptiveChannel.push(message);
     }
+    return deterministicChannel.push(message);
 }
 
 Message* Node::sendMessage(VirtualChannel vc) {
@@ -86,7 +91,7 @@ bool Node::hasMessage(VirtualChannel vc) const {
 }
 
 bool Node::canRoute(Node* destination, VirtualChannel vc) const {
-    for (Link* link : links) {
+    for (Link* link : getLinks()) {
         if (link && link->canTransmit(vc)) {
             return true;
         }
@@ -108,6 +113,6 @@ Packet* Node::getArrivedPacket() {
     return packet;
 }
 
-void Node::addArrivedPacket(Packet* packet) {
-    arrivedPackets.push(packet);
+bool Node::addArrivedPacket(Packet* packet) {
+    return arrivedPackets.push(packet);
 }
\ No newline at end of file
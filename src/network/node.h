@@ -9,9 +9,10 @@
 #ifndef NODE_H
 #define NODE_H
 
-#include <vector>
-#include <queue>
+#include <cstddef>
+#include <cstdint>
 
+#include "ring_queue.h"
 #include "virtual_channel.h"
 
 // Forward declarations
@@ -19,36 +20,64 @@ class Link;
 class Packet;
 class Message;
 
+/**
+ * @brief A node's links: a slice of its network's adjacency array
+ */
+class LinkRange {
+public:
+    LinkRange(Link* const* begin, Link* const* end) : begin_(begin), end_(end) {}
+
+    Link* const* begin() const { return begin_; }
+    Link* const* end() const { return end_; }
+    size_t size() const { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+
+private:
+    Link* const* begin_;
+    Link* const* end_;
+};
+
 class Node {
 public:
     Node(int x, int y);
     Node(int id);
     virtual ~Node();
     
-    void addLink(Link* link);
-    const std::vector<Link*>& getLinks() const;
+    /**
+     * @brief Point the node at its links, which the network owns
+     */
+    void setLinks(Link* const* links, int count);
+    LinkRange getLinks() const;
+
+    /**
+     * @brief Give the node's queues their slots, which the network owns
+     * @param arrivedSlots capacity slots for arrived packets
+     * @param channelSlots 2 * capacity slots: the adaptive channel, then the deterministic one
+     */
+    void attachQueues(Packet** arrivedSlots, Message** channelSlots, uint32_t capacity);
     int getX() const;
     int getY() const;
     int getId() const;
     
-    // Virtual channel support
-    void receiveMessage(Message* message, VirtualChannel vc);
+    // Virtual channel support; a full queue refuses the message or packet
+    bool receiveMessage(Message* message, VirtualChannel vc);
     Message* sendMessage(VirtualChannel vc);
     bool hasMessage(VirtualChannel vc) const;
     bool canRoute(Node* destination, VirtualChannel vc) const;
 
     bool hasArrivedPacket() const;
     Packet* getArrivedPacket();
-    void addArrivedPacket(Packet* packet);
+    bool addArrivedPacket(Packet* packet);
 
 private:
     int id;
     int x, y;
-    std::vector<Link*> links;
-    std::queue<Packet*> arrivedPackets;
+    Link* const* links;
+    int linkCount;
+    RingQueue<Packet*> arrivedPackets;
     
-    std::queue<Message*> adaptiveChannel;
-    std::queue<Message*> deterministicChannel;
+    RingQueue<Message*> adaptiveChannel;
+    RingQueue<Message*> deterministicChannel;
 };
 
 #endif // NODE_H
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <cstdint>
+
+/**
+ * @brief Fixed-capacity FIFO on a power-of-two ring it does not own
+ *
+ * The slots are a slice of one slab the network places in its topology
+ * arena, every queue getting the same capacity (network.buffer_size
+ * rounded up to a power of two), as NodeBufferStore does for the engine's
+ * buffers. Push and pop are an index mask and never allocate; a push
+ * onto a full ring is refused so the caller sees backpressure. A queue
+ * that was never attached has no slots and is always full.
+ */
+template <typename T>
+class RingQueue {
+public:
+    RingQueue() : slots_(nullptr), mask_(0), head_(0), size_(0) {}
+
+    /**
+     * @brief Slots per queue for a requested depth: the next power of two
+     */
+    static uint32_t capacityFor(int depth) {
+        uint32_t capacity = 1;
+        while (capacity < static_cast<uint32_t>(depth > 1 ? depth : 1)) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /**
+     * @param slots capacity slots owned by the caller
+     * @param capacity a power of two, as from capacityFor
+     */
+    void attach(T* slots, uint32_t capacity) {
+        slots_ = slots;
+        mask_ = capacity - 1;
+        head_ = 0;
+        size_ = 0;
+    }
+
+    bool empty() const { return size_ == 0; }
+    bool full() const { return slots_ == nullptr || size_ > mask_; }
+    uint32_t size() const { return size_; }
+
+    T& front() { return slots_[head_]; }
+    const T& front() const { return slots_[head_]; }
+
+    /**
+     * @return false, leaving the queue unchanged, if it is full
+     */
+    bool push(const T& value) {
+        if (full()) {
+            return false;
+        }
+        slots_[(head_ + size_) & mask_] = value;
+        size_++;
+        return true;
+    }
+
+    void pop() {
+        head_ = (head_ + 1) & mask_;
+        size_--;
+    }
+
+private:
+    T* slots_;
+    uint32_t mask_;
+    uint32_t head_;
+    uint32_t size_;
+};
+
+#endif // RING_QUEUE_H
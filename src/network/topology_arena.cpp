@@ -0,0 +1,63 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "network/topology_arena.h"
+#include <cstdint>
+#include <new>
+#include <sys/mman.h>
+
+namespace {
+
+const size_t kHugePageSize = size_t(2) << 20;
+
+} // namespace
+
+TopologyArena::TopologyArena()
+    : mapping_(nullptr), mappingSize_(0), base_(nullptr), used_(0), hugePageBacked_(false) {
+}
+
+TopologyArena::~TopologyArena() {
+    release();
+}
+
+void TopologyArena::reserve(size_t bytes, bool hugePages) {
+    release();
+    if (bytes == 0) {
+        return;
+    }
+
+    // Huge pages need a 2 MiB aligned range, so over-map and align inside it
+    size_t hugeBytes = (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    size_t size = hugePages ? hugeBytes + kHugePageSize : bytes;
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    mapping_ = static_cast<char*>(mapping);
+    mappingSize_ = size;
+    base_ = mapping_;
+
+    if (hugePages) {
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(mapping_) + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        base_ = reinterpret_cast<char*>(aligned);
+#ifdef MADV_HUGEPAGE
+        hugePageBacked_ = madvise(base_, hugeBytes, MADV_HUGEPAGE) == 0;
+#endif
+    }
+}
+
+void TopologyArena::release() {
+    if (mapping_) {
+        munmap(mapping_, mappingSize_);
+    }
+    mapping_ = nullptr;
+    mappingSize_ = 0;
+    base_ = nullptr;
+    used_ = 0;
+    hugePageBacked_ = false;
+}
@@ -0,0 +1,108 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TOPOLOGY_ARENA_H
+#define TOPOLOGY_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief How a network lays out its node and link objects
+ */
+struct TopologyBuildOptions {
+    TopologyBuildOptions() : hugePages(false), threads(1), queueDepth(4) {}
+
+    bool hugePages;  // Ask for transparent huge pages on the arena
+    int threads;     // Construction threads; small networks always use one
+    int queueDepth;  // Messages per node queue (network.buffer_size)
+};
+
+/**
+ * @brief One contiguous block holding a network's nodes, links and adjacency
+ *
+ * The block is mapped once with the total size of everything that will
+ * be placed in it and handed out with a bump pointer, so node and link
+ * arrays sit back to back and a node's links are a slice of one pointer
+ * array (CSR adjacency). Objects are constructed in place by the owning
+ * network, which also runs their destructors; the arena only unmaps.
+ * Large arenas can be backed by transparent huge pages to cut TLB misses
+ * when routing walks the graph.
+ */
+class TopologyArena {
+public:
+    TopologyArena();
+    ~TopologyArena();
+
+    TopologyArena(const TopologyArena&) = delete;
+    TopologyArena& operator=(const TopologyArena&) = delete;
+
+    /**
+     * @brief Map a block of at least bytes, releasing any previous one
+     * @throws std::bad_alloc if the mapping fails
+     */
+    void reserve(size_t bytes, bool hugePages);
+
+    /**
+     * @brief Uninitialized storage for count objects of type T
+     */
+    template <typename T>
+    T* allocate(size_t count) {
+        size_t offset = (used_ + alignof(T) - 1) & ~(alignof(T) - 1);
+        used_ = offset + count * sizeof(T);
+        return reinterpret_cast<T*>(base_ + offset);
+    }
+
+    /**
+     * @brief Upper bound on the bytes allocate<T>(count) consumes
+     */
+    template <typename T>
+    static size_t bytesFor(size_t count) {
+        return count * sizeof(T) + alignof(T);
+    }
+
+    bool isHugePageBacked() const { return hugePageBacked_; }
+
+private:
+    void release();
+
+    char* mapping_;
+    size_t mappingSize_;
+    char* base_;
+    size_t used_;
+    bool hugePageBacked_;
+};
+
+/**
+ * @brief Run fn(begin, end) over [0, count) split across threads
+ *
+ * Networks below kMinNodesPerThread nodes per thread are built inline.
+ */
+template <typename Fn>
+void buildInParallel(int count, int threads, Fn fn) {
+    const int kMinNodesPerThread = 1 << 15;
+    threads = std::max(1, std::min(threads, count / kMinNodesPerThread));
+    if (threads == 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        int begin = static_cast<int>(static_cast<long long>(count) * t / threads);
+        int end = static_cast<int>(static_cast<long long>(count) * (t + 1) / threads);
+        workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // TOPOLOGY_ARENA_H
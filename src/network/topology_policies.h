@@ -0,0 +1,169 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TOPOLOGY_POLICIES_H
+#define TOPOLOGY_POLICIES_H
+
+#include "network/hypercube_kernel.h"
+
+/**
+ * @brief Tags selecting the router model a topology is simulated with
+ */
+struct HypercubeFamily {};
+struct MeshFamily {};
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Hypercube geometry on node ids
+ *
+ * Bit i of a node id is its coordinate in dimension i, so neighbors and
+ * differing dimensions are plain bit operations on ids. Output port i
+ * leads across dimension i.
+ */
+class HypercubeTopology {
+public:
+    using Family = HypercubeFamily;
+
+    explicit HypercubeTopology(int dimension) : dimension_(dimension) {}
+
+    int getNodeCount() const { return 1 << dimension_; }
+    int getDimension() const { return dimension_; }
+
+    int getPortCount() const { return dimension_; }
+
+    int neighborOnPort(int node, int port) const {
+        return HypercubeKernel::neighborInDimension(node, port);
+    }
+
+    /**
+     * @brief Dense index of the directed link leaving node on port
+     */
+    int linkIndex(int node, int port) const { return node * dimension_ + port; }
+    int getLinkCount() const { return getNodeCount() * dimension_; }
+
+    /**
+     * @brief Ports that bring a packet one hop closer to destination
+     */
+    uint32_t minimalPorts(int current, int destination) const {
+        return HypercubeKernel::differingDimensions(current, destination);
+    }
+
+    /**
+     * @brief E-cube port (lowest differing dimension), or -1 if equal
+     */
+    int dimensionOrderPort(int current, int destination) const {
+        return HypercubeKernel::lowestDifferingDimension(current, destination);
+    }
+
+    /**
+     * @brief Usable partition count: requested rounded down to a power of two
+     */
+    int partitionCount(int requested) const {
+        int count = 1;
+        while (count * 2 <= requested && count * 2 <= getNodeCount()) {
+            count *= 2;
+        }
+        return count;
+    }
+
+    /**
+     * @brief First node of a partition; each one is the subcube sharing its top id bits
+     */
+    int partitionBegin(int partition, int count) const {
+        return partition * (getNodeCount() / count);
+    }
+
+private:
+    int dimension_;
+};
+
+/**
+ * @brief 2D mesh geometry on node ids (id = x * sizeY + y)
+ *
+ * Output ports are 0 = +X, 1 = -X, 2 = +Y, 3 = -Y.
+ */
+class MeshTopology {
+public:
+    using Family = MeshFamily;
+
+    enum Port { kPositiveX = 0, kNegativeX = 1, kPositiveY = 2, kNegativeY = 3 };
+
+    MeshTopology(int sizeX, int sizeY) : sizeX_(sizeX), sizeY_(sizeY) {}
+
+    int getNodeCount() const { return sizeX_ * sizeY_; }
+    int getX(int node) const { return node / sizeY_; }
+    int getY(int node) const { return node % sizeY_; }
+
+    int getPortCount() const { return 4; }
+
+    int neighborOnPort(int node, int port) const {
+        switch (port) {
+            case kPositiveX: return node + sizeY_;
+            case kNegativeX: return node - sizeY_;
+            case kPositiveY: return node + 1;
+            default: return node - 1;
+        }
+    }
+
+    /**
+     * @brief Dense index of the directed link leaving node on port
+     */
+    int linkIndex(int node, int port) const { return node * 4 + port; }
+    int getLinkCount() const { return getNodeCount() * 4; }
+
+    /**
+     * @brief Ports that bring a packet one hop closer to destination
+     */
+    uint32_t minimalPorts(int current, int destination) const {
+        int deltaX = getX(destination) - getX(current);
+        int deltaY = getY(destination) - getY(current);
+        uint32_t ports = 0;
+        if (deltaX > 0) ports |= 1u << kPositiveX;
+        if (deltaX < 0) ports |= 1u << kNegativeX;
+        if (deltaY > 0) ports |= 1u << kPositiveY;
+        if (deltaY < 0) ports |= 1u << kNegativeY;
+        return ports;
+    }
+
+    /**
+     * @brief XY port (X corrected first), or -1 if equal
+     */
+    int dimensionOrderPort(int current, int destination) const {
+        int deltaX = getX(destination) - getX(current);
+        if (deltaX != 0) {
+            return deltaX > 0 ? kPositiveX : kNegativeX;
+        }
+        int deltaY = getY(destination) - getY(current);
+        if (deltaY != 0) {
+            return deltaY > 0 ? kPositiveY : kNegativeY;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Usable partition count: at most one per column
+     */
+    int partitionCount(int requested) const {
+        return std::max(1, std::min(requested, sizeX_));
+    }
+
+    /**
+     * @brief First node of a partition; each one is a stripe of whole columns
+     */
+    int partitionBegin(int partition, int count) const {
+        return static_cast<int>(static_cast<long long>(sizeX_) * partition / count) * sizeY_;
+    }
+
+private:
+    int sizeX_;
+    int sizeY_;
+};
+
+#endif // TOPOLOGY_POLICIES_H
@@ -0,0 +1,120 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "routing/compiled_routing_table.h"
+#include "network/virtual_channel.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+const size_t CompiledRoutingTable::kDefaultDenseLimitBytes;
+const size_t CompiledRoutingTable::kCacheLineBytes;
+const int CompiledRoutingTable::kDirections;
+
+namespace {
+
+RouteCandidates queryCandidates(const RoutingAlgorithm& algorithm, int current, int destination) {
+    RoutingState state = {VirtualChannel::ADAPTIVE, 0};
+    return algorithm.computeCandidates(current, destination, state);
+}
+
+} // namespace
+
+CompiledRoutingTable::CompiledRoutingTable(int width, int height)
+    : width_(width), height_(height), dense_(nullptr), stride_(0),
+      nodeRuleSets_(nullptr), ruleRoutes_(nullptr), ruleSetCount_(0) {
+}
+
+std::shared_ptr<const CompiledRoutingTable> CompiledRoutingTable::compile(const RoutingAlgorithm& algorithm,
+                                                                          int width, int height,
+                                                                          size_t denseLimitBytes) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Routing table needs at least one node");
+    }
+
+    std::shared_ptr<CompiledRoutingTable> table(new CompiledRoutingTable(width, height));
+    size_t nodeCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (nodeCount * nodeCount * sizeof(RouteCandidates) <= denseLimitBytes) {
+        table->compileDense(algorithm);
+    } else if (algorithm.hasDirectionalCandidates()) {
+        table->compileRules(algorithm);
+    } else {
+        throw std::invalid_argument("Routing algorithm cannot be compiled for a " + std::to_string(width) + "x" +
+                                    std::to_string(height) + " mesh: its candidates are not directional and a "
+                                    "dense table would exceed " + std::to_string(denseLimitBytes) + " bytes");
+    }
+    return table;
+}
+
+void CompiledRoutingTable::compileDense(const RoutingAlgorithm& algorithm) {
+    const int nodeCount = getNodeCount();
+
+    // Round rows up to whole cache lines and leave room to align the first one
+    const size_t entriesPerLine = kCacheLineBytes / sizeof(RouteCandidates);
+    stride_ = (static_cast<size_t>(nodeCount) + entriesPerLine - 1) / entriesPerLine * entriesPerLine;
+    denseStorage_.assign(stride_ * static_cast<size_t>(nodeCount) + entriesPerLine - 1, RouteCandidates{0u, 0u});
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(denseStorage_.data());
+    size_t misalignment = (kCacheLineBytes - address % kCacheLineBytes) % kCacheLineBytes;
+    RouteCandidates* rows = denseStorage_.data() + misalignment / sizeof(RouteCandidates);
+
+    for (int current = 0; current < nodeCount; ++current) {
+        RouteCandidates* row = rows + static_cast<size_t>(current) * stride_;
+        for (int destination = 0; destination < nodeCount; ++destination) {
+            row[destination] = queryCandidates(algorithm, current, destination);
+        }
+    }
+    dense_ = rows;
+}
+
+void CompiledRoutingTable::compileRules(const RoutingAlgorithm& algorithm) {
+    typedef std::array<uint64_t, kDirections> RuleSetKey;
+    std::map<RuleSetKey, uint32_t> ruleSets;
+    nodeRuleSetStorage_.resize(static_cast<size_t>(getNodeCount()));
+
+    for (int x = 0; x < width_; ++x) {
+        for (int y = 0; y < height_; ++y) {
+            int current = x * height_ + y;
+
+            // Any destination in a direction gets the same candidates, so ask about the nearest;
+            // directions leading off the mesh have none
+            RouteCandidates rules[kDirections];
+            RuleSetKey key;
+            for (int direction = 0; direction < kDirections; ++direction) {
+                int nextX = x + direction / 3 - 1;
+                int nextY = y + direction % 3 - 1;
+                bool onMesh = nextX >= 0 && nextX < width_ && nextY >= 0 && nextY < height_;
+                rules[direction] = onMesh ? queryCandidates(algorithm, current, nextX * height_ + nextY)
+                                          : RouteCandidates{0u, 0u};
+                key[direction] = static_cast<uint64_t>(rules[direction].adaptivePorts) << 32 |
+                                 rules[direction].escapePorts;
+            }
+
+            auto inserted = ruleSets.insert(std::make_pair(key, static_cast<uint32_t>(ruleSets.size())));
+            if (inserted.second) {
+                ruleRouteStorage_.insert(ruleRouteStorage_.end(), rules, rules + kDirections);
+            }
+            nodeRuleSetStorage_[current] = inserted.first->second;
+        }
+    }
+
+    nodeRuleSets_ = nodeRuleSetStorage_.data();
+    ruleRoutes_ = ruleRouteStorage_.data();
+    ruleSetCount_ = ruleSets.size();
+}
+
+size_t CompiledRoutingTable::getMemoryBytes() const {
+    if (dense_) {
+        return stride_ * static_cast<size_t>(getNodeCount()) * sizeof(RouteCandidates);
+    }
+    return static_cast<size_t>(getNodeCount()) * sizeof(uint32_t) +
+           ruleSetCount_ * kDirections * sizeof(RouteCandidates);
+}
@@ -0,0 +1,115 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef COMPILED_ROUTING_TABLE_H
+#define COMPILED_ROUTING_TABLE_H
+
+#include "routing/routing_algorithm.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Candidate ports of a routing algorithm for every (node, destination) of a mesh
+ *
+ * Small meshes get a dense table built by querying
+ * RoutingAlgorithm::computeCandidates for each pair; rows start on
+ * cache-line boundaries, so a hop is one load. Past the dense limit the
+ * algorithm must have directional candidates (see
+ * RoutingAlgorithm::hasDirectionalCandidates), and each node instead
+ * keeps one rule per destination direction: lower, same or higher in
+ * each dimension, nine in all. That takes nine queries per node, and
+ * nodes with the same nine entries (every interior node, in practice)
+ * share one rule set, so a hop is the node's rule set index and one
+ * entry of it.
+ *
+ * The table assumes candidates do not depend on RoutingState, which holds
+ * for every algorithm in the tree.
+ *
+ * Lookups read through plain pointers, so the arrays may live either in
+ * the table's own vectors (after compile) or in a read-only file mapping
+ * shared with other processes (see RoutingTableCache).
+ */
+class CompiledRoutingTable {
+public:
+    static const size_t kDefaultDenseLimitBytes = size_t(1) << 20;
+    static const int kDirections = 9;
+
+    /**
+     * @brief Compile the candidates of algorithm on a width x height mesh (id = x * height + y)
+     * @param denseLimitBytes Largest dense table; bigger meshes are compiled into rules
+     * @throws std::invalid_argument if the mesh is too large for a dense table
+     *         and the algorithm's candidates are not directional
+     */
+    static std::shared_ptr<const CompiledRoutingTable> compile(const RoutingAlgorithm& algorithm, int width,
+                                                               int height,
+                                                               size_t denseLimitBytes = kDefaultDenseLimitBytes);
+
+    RouteCandidates lookup(int current, int destination) const {
+        if (dense_) {
+            return dense_[static_cast<size_t>(current) * stride_ + static_cast<size_t>(destination)];
+        }
+        return lookupRule(current, destination);
+    }
+
+    int getNodeCount() const { return width_ * height_; }
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    bool isDense() const { return dense_ != nullptr; }
+    size_t getRuleSetCount() const { return ruleSetCount_; }
+    size_t getMemoryBytes() const;
+
+private:
+    friend class RoutingTableCache;
+
+    static const size_t kCacheLineBytes = 64;
+
+    CompiledRoutingTable(int width, int height);
+    CompiledRoutingTable(const CompiledRoutingTable&) = delete;
+    CompiledRoutingTable& operator=(const CompiledRoutingTable&) = delete;
+
+    void compileDense(const RoutingAlgorithm& algorithm);
+    void compileRules(const RoutingAlgorithm& algorithm);
+
+    // Direction of b from a: 3 * (x step + 1) + (y step + 1), steps in {-1, 0, 1}
+    int directionOf(int a, int b) const {
+        int ax = a / height_;
+        int bx = b / height_;
+        int ay = a - ax * height_;
+        int by = b - bx * height_;
+        return 3 * ((bx > ax) - (bx < ax) + 1) + (by > ay) - (by < ay) + 1;
+    }
+
+    RouteCandidates lookupRule(int current, int destination) const {
+        return ruleRoutes_[static_cast<size_t>(nodeRuleSets_[current]) * kDirections +
+                           directionOf(current, destination)];
+    }
+
+    int width_;
+    int height_;
+
+    // Dense layout: row r starts at dense_ + r * stride_
+    const RouteCandidates* dense_;
+    size_t stride_;
+
+    // Rule layout: node n uses ruleRoutes_[nodeRuleSets_[n] * kDirections, + kDirections)
+    const uint32_t* nodeRuleSets_;
+    const RouteCandidates* ruleRoutes_;
+    size_t ruleSetCount_;
+
+    // Backing storage of a compiled table
+    std::vector<RouteCandidates> denseStorage_;
+    std::vector<uint32_t> nodeRuleSetStorage_;
+    std::vector<RouteCandidates> ruleRouteStorage_;
+
+    // Backing storage of a table loaded from a file, released with the table
+    std::shared_ptr<const void> mapping_;
+};
+
+#endif // COMPILED_ROUTING_TABLE_H
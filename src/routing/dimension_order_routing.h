@@ -0,0 +1,34 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef DIMENSION_ORDER_ROUTING_H
+#define DIMENSION_ORDER_ROUTING_H
+
+#include "network/topology_policies.h"
+#include "routing/routing_algorithm.h"
+
+/**
+ * @brief Dimension-order next-hop policy (E-cube on hypercubes, XY on meshes)
+ *
+ * Corrects the lowest differing dimension first. Works on any topology
+ * policy that exposes dimensionOrderPort(). As a per-hop policy it offers
+ * only the dimension-order port, on the escape (deterministic) channel
+ * class.
+ */
+class DimensionOrderRouting {
+public:
+    template <typename Topology>
+    RouteCandidates candidates(const Topology& topology, int current, int destination,
+                               const RoutingState& /*state*/) const {
+        int port = topology.dimensionOrderPort(current, destination);
+        RouteCandidates route = {0u, port < 0 ? 0u : (1u << port)};
+        return route;
+    }
+};
+
+#endif // DIMENSION_ORDER_ROUTING_H
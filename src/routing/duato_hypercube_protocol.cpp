@@ -9,6 +9,9 @@
 #include "routing/duato_hypercube_protocol.h"
 #include "network/hypercube_network.h"
 #include "network/hypercube_node.h"
+#include "network/hypercube_kernel.h"
+#include "network/topology_policies.h"
+#include "routing/duato_routing.h"
 #include "utils/config.h"
 
 DuatoHypercubeProtocol::DuatoHypercubeProtocol(HypercubeNetwork* network) 
@@ -77,18 +80,28 @@ RoutingResult DuatoHypercubeProtocol::routeMessageWithStats(Message& message, No
     return result;
 }
 
+RouteCandidates DuatoHypercubeProtocol::computeCandidates(int currentId, int destinationId,
+                                                          const RoutingState& state) const {
+    if (!hypercubeNetwork) {
+        return RouteCandidates{0u, 0u};
+    }
+    // Any differing dimension on the adaptive class, E-cube as the escape
+    return DuatoRouting().candidates(HypercubeTopology(hypercubeNetwork->getDimension()),
+                                     currentId, destinationId, state);
+}
+
 int DuatoHypercubeProtocol::selectNextDimension(Node* current, Node* destination) const {
     HypercubeNode* currentHC = static_cast<HypercubeNode*>(current);
     HypercubeNode* destHC = static_cast<HypercubeNode*>(destination);
     
     if (!currentHC || !destHC) return -1;
     
-    std::vector<int> dimensionPriorities = getDeterministicDimensionOrder(currentHC, destHC);
-    
     if (canUseAdaptiveChannel(currentHC, -1, destHC)) {
         return selectAdaptiveDimension(currentHC, destHC);
     }
     
+    // The priority list is only built when the escape channel is needed
+    std::vector<int> dimensionPriorities = getDeterministicDimensionOrder(currentHC, destHC);
     for (int dim : dimensionPriorities) {
         if (needsRoutingInDimension(currentHC, destHC, dim)) {
             return dim;
@@ -117,7 +130,7 @@ bool DuatoHypercubeProtocol::canUseAdaptiveChannel(HypercubeNode* current, int t
 }
 
 bool DuatoHypercubeProtocol::mustUseDeterministicChannel(HypercubeNode* current, HypercubeNode* destination) const {
-    int hammingDistance = hypercubeNetwork->getHammingDistance(current->getId(), destination->getId());
+    int hammingDistance = HypercubeKernel::hammingDistance(current->getId(), destination->getId());
     return hammingDistance <= 1;
 }
 
@@ -146,29 +159,17 @@ std::vector<int> DuatoHypercubeProtocol::getDeterministicDimensionOrder(Hypercub
 }
 
 bool DuatoHypercubeProtocol::needsRoutingInDimension(HypercubeNode* current, HypercubeNode* destination, int dimension) const {
-    const auto& currentCoords = current->getCoordinates();
-    const auto& destCoords = destination->getCoordinates();
-    
-    if (dimension >= static_cast<int>(currentCoords.size()) || 
-        dimension >= static_cast<int>(destCoords.size())) {
+    if (dimension < 0 || dimension >= current->getDimension() || 
+        dimension >= destination->getDimension()) {
         return false;
     }
     
-    return currentCoords[dimension] != destCoords[dimension];
+    return HypercubeKernel::differsInDimension(current->getId(), destination->getId(), dimension);
 }
 
 int DuatoHypercubeProtocol::selectAdaptiveDimension(HypercubeNode* current, HypercubeNode* destination) const {
-    std::vector<int> validDimensions;
-    
-    for (int dim = 0; dim < hypercubeNetwork->getDimension(); ++dim) {
-        if (needsRoutingInDimension(current, destination, dim)) {
-            validDimensions.push_back(dim);
-        }
-    }
-    
-    if (validDimensions.empty()) return -1;
-    
-    return validDimensions[0];
+    // Lowest dimension still to be corrected
+    return HypercubeKernel::lowestDifferingDimension(current->getId(), destination->getId());
 }
 
 bool DuatoHypercubeProtocol::isVirtualChannelAvailable(HypercubeNode* from, HypercubeNode* to, VirtualChannel vc) const {
@@ -25,6 +25,8 @@ public:
     
     void routeMessage(Message& message, Node* source, Node* destination) override;
     RoutingResult routeMessageWithStats(Message& message, Node* source, Node* destination) override;
+    RouteCandidates computeCandidates(int currentId, int destinationId,
+                                      const RoutingState& state) const override;
     
     std::string getAlgorithmDescription() const;
     std::string getBaselineAlgorithm() const;
@@ -8,8 +8,10 @@
  */
 
 #include "duato_protocol.h"
+#include "duato_routing.h"
 #include "network/network.h"
 #include "network/node.h"
+#include "network/topology_policies.h"
 #include "message/message.h"
 #include "utils/config.h"
 #include <vector>
@@ -52,6 +54,16 @@ RoutingResult DuatoProtocol::routeMessageWithStats(Message& message, Node* sourc
     return result;
 }
 
+RouteCandidates DuatoProtocol::computeCandidates(int currentId, int destinationId,
+                                                 const RoutingState& state) const {
+    if (!network) {
+        return RouteCandidates{0u, 0u};
+    }
+    // Simulator ids are x * height + y; minimal directions adaptive, XY as the escape
+    return DuatoRouting().candidates(MeshTopology(network->getWidth(), network->getHeight()),
+                                     currentId, destinationId, state);
+}
+
 std::vector<Node*> DuatoProtocol::findPath(Node* source, Node* destination) const {
     std::vector<Node*> path;
     Node* current = source;
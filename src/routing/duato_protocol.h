@@ -31,6 +31,9 @@ public:
 
     void routeMessage(Message& message, Node* source, Node* destination) override;
     RoutingResult routeMessageWithStats(Message& message, Node* source, Node* destination) override;
+    RouteCandidates computeCandidates(int currentId, int destinationId,
+                                      const RoutingState& state) const override;
+    bool hasDirectionalCandidates() const override { return true; }
     
     void setNetwork(Network* network) override;
     Network* getNetwork() const override;
@@ -0,0 +1,34 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef DUATO_ROUTING_H
+#define DUATO_ROUTING_H
+
+#include "network/topology_policies.h"
+#include "routing/routing_algorithm.h"
+
+/**
+ * @brief Duato's protocol as a per-hop policy
+ *
+ * Every minimal port is a candidate on the adaptive channel class, and the
+ * dimension-order port (E-cube on hypercubes, XY on meshes) is the escape
+ * channel, whose acyclic dependency graph keeps the network deadlock-free.
+ */
+class DuatoRouting {
+public:
+    template <typename Topology>
+    RouteCandidates candidates(const Topology& topology, int current, int destination,
+                               const RoutingState& /*state*/) const {
+        int escapePort = topology.dimensionOrderPort(current, destination);
+        RouteCandidates route = {topology.minimalPorts(current, destination),
+                                 escapePort < 0 ? 0u : (1u << escapePort)};
+        return route;
+    }
+};
+
+#endif // DUATO_ROUTING_H
@@ -9,7 +9,11 @@
 #include "routing/ecube_routing.h"
 #include "network/hypercube_network.h"
 #include "network/hypercube_node.h"
+#include "network/hypercube_kernel.h"
+#include "network/topology_policies.h"
+#include "routing/dimension_order_routing.h"
 #include "message/message.h"
+#include <cstddef>
 
 EcubeRouting::EcubeRouting(HypercubeNetwork* network) : hypercubeNetwork(network) {
     this->network = network;
@@ -48,6 +52,15 @@ RoutingResult EcubeRouting::routeMessageWithStats(Message& message, Node* source
     return result;
 }
 
+RouteCandidates EcubeRouting::computeCandidates(int currentId, int destinationId,
+                                                const RoutingState& state) const {
+    if (!hypercubeNetwork) {
+        return RouteCandidates{0u, 0u};
+    }
+    return DimensionOrderRouting().candidates(HypercubeTopology(hypercubeNetwork->getDimension()),
+                                              currentId, destinationId, state);
+}
+
 void EcubeRouting::setNetwork(Network* network) {
     this->network = network;
     this->hypercubeNetwork = dynamic_cast<HypercubeNetwork*>(network);
@@ -68,25 +81,13 @@ std::vector<Node*> EcubeRouting::calculatePath(Node* source, Node* destination)
     HypercubeNode* hypercubeDest = dynamic_cast<HypercubeNode*>(destination);
     
     if (hypercubeSource && hypercubeDest) {
+        path.reserve(HypercubeKernel::hammingDistance(source->getId(), destination->getId()) + 1);
         path.push_back(source);
         
-        auto sourceCoords = hypercubeSource->getCoordinates();
-        auto destCoords = hypercubeDest->getCoordinates();
-        
-        Node* current = source;
-        while (current != destination) {
-            HypercubeNode* currentHyper = dynamic_cast<HypercubeNode*>(current);
-            if (!currentHyper) break;
-            
-            auto currentCoords = currentHyper->getCoordinates();
-            
-            Node* next = nullptr;
-            for (int dim = 0; dim < static_cast<int>(currentCoords.size()); ++dim) {
-                if (currentCoords[dim] != destCoords[dim]) {
-                    next = currentHyper->getNeighborInDimension(dim);
-                    break;
-                }
-            }
+        HypercubeNode* current = hypercubeSource;
+        while (current != hypercubeDest) {
+            int dim = HypercubeKernel::lowestDifferingDimension(current->getId(), hypercubeDest->getId());
+            HypercubeNode* next = current->getNeighborInDimension(dim);
             
             if (!next || next == current) break;
             
@@ -99,20 +100,9 @@ std::vector<Node*> EcubeRouting::calculatePath(Node* source, Node* destination)
 }
 
 int EcubeRouting::selectNextDimension(Node* current, Node* destination) const {
-    HypercubeNode* currentHC = dynamic_cast<HypercubeNode*>(current);
-    HypercubeNode* destHC = dynamic_cast<HypercubeNode*>(destination);
+    if (!current || !destination) return -1;
     
-    if (!currentHC || !destHC) return -1;
-    
-    std::vector<int> differences = calculateDimensionDifferences(currentHC, destHC);
-    
-    for (int dim = 0; dim < static_cast<int>(differences.size()); ++dim) {
-        if (differences[dim] != 0) {
-            return dim;
-        }
-    }
-    
-    return -1;
+    return HypercubeKernel::lowestDifferingDimension(current->getId(), destination->getId());
 }
 
 std::vector<int> EcubeRouting::calculateDimensionDifferences(Node* source, Node* destination) const {
@@ -122,11 +112,10 @@ std::vector<int> EcubeRouting::calculateDimensionDifferences(Node* source, Node*
     std::vector<int> differences;
     if (!sourceHC || !destHC) return differences;
     
-    const auto& sourceCoords = sourceHC->getCoordinates();
-    const auto& destCoords = destHC->getCoordinates();
-    
-    for (size_t i = 0; i < sourceCoords.size() && i < destCoords.size(); ++i) {
-        differences.push_back(destCoords[i] - sourceCoords[i]);
+    int dimension = sourceHC->getDimension();
+    differences.resize(dimension);
+    for (int dim = 0; dim < dimension; ++dim) {
+        differences[dim] = ((destHC->getId() >> dim) & 1) - ((sourceHC->getId() >> dim) & 1);
     }
     
     return differences;
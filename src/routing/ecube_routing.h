@@ -22,6 +22,8 @@ public:
     
     void routeMessage(Message& message, Node* source, Node* destination) override;
     RoutingResult routeMessageWithStats(Message& message, Node* source, Node* destination) override;
+    RouteCandidates computeCandidates(int currentId, int destinationId,
+                                      const RoutingState& state) const override;
     
     void setNetwork(Network* network) override;
     Network* getNetwork() const override;
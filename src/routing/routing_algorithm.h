@@ -9,6 +9,8 @@
 #ifndef ROUTING_ALGORITHM_H
 #define ROUTING_ALGORITHM_H
 
+#include "network/virtual_channel.h"
+#include <cstdint>
 #include <vector>
 
 // Forward declarations
@@ -27,6 +29,29 @@ struct RoutingResult {
     RoutingResult() : success(false), hopCount(0), delay(0.0), totalDelay(0.0) {}
 };
 
+/**
+ * @brief Output ports a packet may take from one node, per VC class
+ *
+ * Bit p stands for output port p of the current node, numbered as in the
+ * topology policies (the dimension on hypercubes; +X, -X, +Y, -Y on
+ * meshes). Adaptive ports use the adaptive virtual channel class, escape
+ * ports the deterministic one. Both are empty at the destination.
+ */
+struct RouteCandidates {
+    uint32_t adaptivePorts;
+    uint32_t escapePorts;
+
+    bool empty() const { return (adaptivePorts | escapePorts) == 0; }
+};
+
+/**
+ * @brief Per-packet state a routing decision may depend on
+ */
+struct RoutingState {
+    VirtualChannel channel;  // Class of the channel the packet arrived on
+    int hopCount;
+};
+
 class RoutingAlgorithm {
 public:
     RoutingAlgorithm() : network(nullptr) {}
@@ -34,6 +59,24 @@ public:
     
     virtual void routeMessage(Message& message, Node* source, Node* destination) = 0;
     virtual RoutingResult routeMessageWithStats(Message& message, Node* source, Node* destination) = 0;
+
+    /**
+     * @brief Candidate output ports for one hop, without allocating
+     * @param currentId Simulator node id the packet is at
+     * @param destinationId Simulator node id the packet is bound for
+     * @param state Per-packet routing state
+     */
+    virtual RouteCandidates computeCandidates(int currentId, int destinationId,
+                                              const RoutingState& state) const = 0;
+
+    /**
+     * @brief Whether candidates depend on the destination only through its
+     *        direction (lower, same or higher) in each mesh dimension
+     *
+     * Lets meshes too large for a dense table compile the algorithm into
+     * per-direction rules (see CompiledRoutingTable).
+     */
+    virtual bool hasDirectionalCandidates() const { return false; }
     
     virtual void setNetwork(Network* net) { network = net; }
     virtual Network* getNetwork() const { return network; }
@@ -15,16 +15,15 @@
 #include "../network/hypercube_network.h"
 #include "../utils/config.h"
 #include <stdexcept>
+#include <mutex>
 #include <iostream>
 
 RoutingFactory& RoutingFactory::getInstance() {
     static RoutingFactory instance;
-    static bool initialized = false;
+    static std::once_flag initialized;
     
-    if (!initialized) {
-        instance.initializeBuiltinAlgorithms();
-        initialized = true;
-    }
+    // Sweep workers may reach the factory concurrently
+    std::call_once(initialized, [] { instance.initializeBuiltinAlgorithms(); });
     
     return instance;
 }
@@ -45,19 +44,7 @@ std::unique_ptr<RoutingAlgorithm> RoutingFactory::createRoutingAlgorithm(Network
     std::string key = makeKey(algorithm, topology);
     auto it = creators_.find(key);
     
-    // If not found, try the default algorithm for this topology
-    if (it == creators_.end()) {
-        std::string defaultAlg = getDefaultAlgorithm(topology);
-        if (!defaultAlg.empty()) {
-            std::cout << "Warning: Algorithm '" << algorithm 
-                      << "' not supported for topology '" << topology 
-                      << "'. Using default: " << defaultAlg << std::endl;
-            algorithm = defaultAlg;
-            key = makeKey(algorithm, topology);
-            it = creators_.find(key);
-        }
-    }
-    
+    // A misspelled algorithm must not quietly run the topology's default
     if (it == creators_.end()) {
         throw std::invalid_argument("No suitable routing algorithm found for topology: " + topology + 
                                    " with algorithm: " + algorithm + 
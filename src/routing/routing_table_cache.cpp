@@ -0,0 +1,287 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "routing/routing_table_cache.h"
+#include "network/topology_policies.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const char kMagic[8] = {'O', 'M', 'N', 'I', 'R', 'T', 'C', '\0'};
+const uint32_t kFormatVersion = 2;
+const uint32_t kByteOrderMark = 0x01020304u;
+const uint64_t kSectionAlignment = 64;
+
+/**
+ * @brief Fixed part of a cache file; the key text follows it
+ *
+ * Sections start on cache-line boundaries after the key. A dense table
+ * stores stride * nodeCount entries; a rule table stores each node's rule
+ * set index and then the rule sets, in that order.
+ */
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t keyBytes;
+    int32_t width;
+    int32_t height;
+    uint32_t dense;
+    uint64_t stride;
+    uint64_t ruleSetCount;
+    uint64_t fileBytes;
+};
+
+struct SectionLayout {
+    uint64_t dense;
+    uint64_t nodeRuleSets;
+    uint64_t ruleRoutes;
+    uint64_t end;
+};
+
+uint64_t alignUp(uint64_t offset) {
+    return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+SectionLayout layoutFor(const FileHeader& header) {
+    SectionLayout layout = {0, 0, 0, 0};
+    uint64_t nodeCount = static_cast<uint64_t>(header.width) * static_cast<uint64_t>(header.height);
+    uint64_t offset = alignUp(sizeof(FileHeader) + header.keyBytes);
+    if (header.dense) {
+        layout.dense = offset;
+        offset += header.stride * nodeCount * sizeof(RouteCandidates);
+    } else {
+        layout.nodeRuleSets = offset;
+        offset = alignUp(offset + nodeCount * sizeof(uint32_t));
+        layout.ruleRoutes = offset;
+        offset += header.ruleSetCount * CompiledRoutingTable::kDirections * sizeof(RouteCandidates);
+    }
+    layout.end = offset;
+    return layout;
+}
+
+// FNV-1a; collisions are caught by comparing the stored key
+uint64_t hashKey(const std::string& key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void writePadding(std::ofstream& out, uint64_t from, uint64_t to) {
+    static const char zeros[kSectionAlignment] = {};
+    out.write(zeros, static_cast<std::streamsize>(to - from));
+}
+
+// Ports of node that lead to another node of the mesh
+uint32_t meshPorts(int width, int height, int node) {
+    int x = node / height;
+    int y = node % height;
+    uint32_t ports = 0;
+    if (x + 1 < width) ports |= 1u << MeshTopology::kPositiveX;
+    if (x > 0) ports |= 1u << MeshTopology::kNegativeX;
+    if (y + 1 < height) ports |= 1u << MeshTopology::kPositiveY;
+    if (y > 0) ports |= 1u << MeshTopology::kNegativeY;
+    return ports;
+}
+
+bool withinPorts(const RouteCandidates& route, uint32_t ports) {
+    return ((route.adaptivePorts | route.escapePorts) & ~ports) == 0;
+}
+
+// The engine follows every candidate port to a neighbor and its link, so a
+// corrupt or stale file must not name a port off the edge of the mesh
+bool validDense(const RouteCandidates* dense, uint64_t stride, int width, int height) {
+    int nodeCount = width * height;
+    for (int node = 0; node < nodeCount; ++node) {
+        uint32_t ports = meshPorts(width, height, node);
+        const RouteCandidates* row = dense + static_cast<uint64_t>(node) * stride;
+        for (int destination = 0; destination < nodeCount; ++destination) {
+            if (!withinPorts(row[destination], ports)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Rule set indices also select a slice of the file, so they must stay in range
+bool validRules(const uint32_t* nodeRuleSets, const RouteCandidates* ruleRoutes, uint64_t ruleSetCount, int width,
+                int height) {
+    int nodeCount = width * height;
+    for (int node = 0; node < nodeCount; ++node) {
+        if (nodeRuleSets[node] >= ruleSetCount) {
+            return false;
+        }
+        uint32_t ports = meshPorts(width, height, node);
+        const RouteCandidates* rules = ruleRoutes + static_cast<uint64_t>(nodeRuleSets[node]) *
+                                                        CompiledRoutingTable::kDirections;
+        for (int direction = 0; direction < CompiledRoutingTable::kDirections; ++direction) {
+            if (!withinPorts(rules[direction], ports)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+RoutingTableCache::RoutingTableCache(const std::string& directory) : directory_(directory) {
+}
+
+std::string RoutingTableCache::pathFor(const std::string& key) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "routing-%016llx.table", static_cast<unsigned long long>(hashKey(key)));
+    return directory_ + "/" + name;
+}
+
+std::shared_ptr<const CompiledRoutingTable> RoutingTableCache::findOrCompile(const std::string& key,
+                                                                             const RoutingAlgorithm& algorithm,
+                                                                             int width, int height) const {
+    std::shared_ptr<const CompiledRoutingTable> table = load(key, width, height);
+    if (table) {
+        std::cout << "Mapped cached routing table: " << pathFor(key) << std::endl;
+        return table;
+    }
+
+    table = CompiledRoutingTable::compile(algorithm, width, height);
+    if (store(key, *table)) {
+        std::cout << "Cached routing table: " << pathFor(key) << std::endl;
+    } else {
+        std::cerr << "Warning: could not write routing table cache " << pathFor(key) << std::endl;
+    }
+    return table;
+}
+
+std::shared_ptr<const CompiledRoutingTable> RoutingTableCache::load(const std::string& key, int width,
+                                                                    int height) const {
+    int fd = open(pathFor(key).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t fileBytes = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, fileBytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    std::shared_ptr<const void> mapping(address, [fileBytes](const void* base) {
+        munmap(const_cast<void*>(base), fileBytes);
+    });
+
+    const char* base = static_cast<const char*>(address);
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion ||
+        header.byteOrder != kByteOrderMark || header.width != width || header.height != height ||
+        header.fileBytes != fileBytes ||
+        header.keyBytes != key.size() || sizeof(FileHeader) + header.keyBytes > fileBytes ||
+        key.compare(0, key.size(), base + sizeof(FileHeader), header.keyBytes) != 0) {
+        return nullptr;
+    }
+    int nodeCount = width * height;
+    if (header.dense ? (header.stride < static_cast<uint64_t>(nodeCount) ||
+                        header.stride > static_cast<uint64_t>(nodeCount) + kSectionAlignment)
+                     : header.ruleSetCount > static_cast<uint64_t>(nodeCount)) {
+        return nullptr;
+    }
+    SectionLayout layout = layoutFor(header);
+    if (layout.end != fileBytes) {
+        return nullptr;
+    }
+
+    std::shared_ptr<CompiledRoutingTable> table(new CompiledRoutingTable(width, height));
+    if (header.dense) {
+        table->dense_ = reinterpret_cast<const RouteCandidates*>(base + layout.dense);
+        table->stride_ = static_cast<size_t>(header.stride);
+        if (!validDense(table->dense_, header.stride, width, height)) {
+            return nullptr;
+        }
+    } else {
+        table->nodeRuleSets_ = reinterpret_cast<const uint32_t*>(base + layout.nodeRuleSets);
+        table->ruleRoutes_ = reinterpret_cast<const RouteCandidates*>(base + layout.ruleRoutes);
+        table->ruleSetCount_ = static_cast<size_t>(header.ruleSetCount);
+        if (!validRules(table->nodeRuleSets_, table->ruleRoutes_, header.ruleSetCount, width, height)) {
+            return nullptr;
+        }
+    }
+    table->mapping_ = mapping;
+    return table;
+}
+
+bool RoutingTableCache::store(const std::string& key, const CompiledRoutingTable& table) const {
+    if (mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.byteOrder = kByteOrderMark;
+    header.keyBytes = static_cast<uint32_t>(key.size());
+    header.width = table.width_;
+    header.height = table.height_;
+    header.dense = table.isDense() ? 1 : 0;
+    header.stride = table.stride_;
+    header.ruleSetCount = table.ruleSetCount_;
+    SectionLayout layout = layoutFor(header);
+    header.fileBytes = layout.end;
+
+    // Readers only ever see a complete file: write a private name, then rename over
+    std::string path = pathFor(key);
+    std::string temporaryPath = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        uint64_t offset = sizeof(header) + key.size();
+        if (header.dense) {
+            writePadding(out, offset, layout.dense);
+            out.write(reinterpret_cast<const char*>(table.dense_),
+                      static_cast<std::streamsize>(layout.end - layout.dense));
+        } else {
+            size_t nodeBytes = static_cast<size_t>(table.getNodeCount()) * sizeof(uint32_t);
+            writePadding(out, offset, layout.nodeRuleSets);
+            out.write(reinterpret_cast<const char*>(table.nodeRuleSets_), static_cast<std::streamsize>(nodeBytes));
+            writePadding(out, layout.nodeRuleSets + nodeBytes, layout.ruleRoutes);
+            out.write(reinterpret_cast<const char*>(table.ruleRoutes_),
+                      static_cast<std::streamsize>(layout.end - layout.ruleRoutes));
+        }
+        if (!out) {
+            out.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef ROUTING_TABLE_CACHE_H
+#define ROUTING_TABLE_CACHE_H
+
+#include "routing/compiled_routing_table.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief On-disk cache of compiled routing tables, loaded with mmap
+ *
+ * Compiling a table queries the routing algorithm for every (node,
+ * destination) pair of a small mesh, or nine times per node of a large
+ * one. The cache
+ * keeps each table in a file named after a hash of its key (everything
+ * the contents depend on) and maps it read-only on later launches, so
+ * lookups read the mapped pages in place and concurrent processes share
+ * them through the page cache. Files are written under a temporary name
+ * and renamed, so readers never see a partial table. A file whose header
+ * or stored key does not match, or whose entries name a port leading off
+ * the mesh or a rule set past its end, is ignored and rewritten.
+ */
+class RoutingTableCache {
+public:
+    explicit RoutingTableCache(const std::string& directory);
+
+    /**
+     * @brief Map the table cached under key, or compile it and try to cache it
+     * @param key Topology, size and algorithm the table is compiled for
+     */
+    std::shared_ptr<const CompiledRoutingTable> findOrCompile(const std::string& key, const RoutingAlgorithm& algorithm,
+                                                              int width, int height) const;
+
+    /**
+     * @brief Map a cached table, or return null if there is no valid one
+     */
+    std::shared_ptr<const CompiledRoutingTable> load(const std::string& key, int width, int height) const;
+
+    /**
+     * @brief Write table to the cache
+     * @return False if the directory or file could not be written
+     */
+    bool store(const std::string& key, const CompiledRoutingTable& table) const;
+
+    std::string pathFor(const std::string& key) const;
+
+private:
+    std::string directory_;
+};
+
+#endif // ROUTING_TABLE_CACHE_H
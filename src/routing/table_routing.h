@@ -0,0 +1,39 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TABLE_ROUTING_H
+#define TABLE_ROUTING_H
+
+#include "routing/compiled_routing_table.h"
+#include "routing/routing_algorithm.h"
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Per-hop policy that reads candidates from a compiled table
+ *
+ * Lets any RoutingAlgorithm drive SimulatorCore: its decisions are
+ * compiled once (see CompiledRoutingTable) and each hop is a table
+ * lookup. The table is shared and never modified.
+ */
+class TableRouting {
+public:
+    explicit TableRouting(std::shared_ptr<const CompiledRoutingTable> table = nullptr)
+        : table_(std::move(table)) {}
+
+    template <typename Topology>
+    RouteCandidates candidates(const Topology& /*topology*/, int current, int destination,
+                               const RoutingState& /*state*/) const {
+        return table_->lookup(current, destination);
+    }
+
+private:
+    std::shared_ptr<const CompiledRoutingTable> table_;
+};
+
+#endif // TABLE_ROUTING_H
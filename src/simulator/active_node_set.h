@@ -0,0 +1,74 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef ACTIVE_NODE_SET_H
+#define ACTIVE_NODE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bitmap of node ids that currently hold packets
+ *
+ * next() walks set bits in ascending id order with find-first-set, so a
+ * sweep over the active nodes visits them in exactly the order a full
+ * 0..N-1 scan would, while skipping 64 idle nodes per word.
+ */
+class ActiveNodeSet {
+public:
+    void resize(int nodeCount) {
+        words_.assign((static_cast<size_t>(nodeCount) + 63) / 64, 0);
+    }
+
+    void clear() {
+        words_.assign(words_.size(), 0);
+    }
+
+    void insert(int node) {
+        words_[node >> 6] |= (uint64_t(1) << (node & 63));
+    }
+
+    void erase(int node) {
+        words_[node >> 6] &= ~(uint64_t(1) << (node & 63));
+    }
+
+    bool contains(int node) const {
+        return (words_[node >> 6] >> (node & 63)) & 1;
+    }
+
+    /**
+     * @brief Smallest active node id >= from, or -1 if there is none
+     */
+    int next(int from) const {
+        size_t word = static_cast<size_t>(from) >> 6;
+        if (word >= words_.size()) {
+            return -1;
+        }
+        uint64_t bits = words_[word] & (~uint64_t(0) << (from & 63));
+        while (bits == 0) {
+            if (++word >= words_.size()) {
+                return -1;
+            }
+            bits = words_[word];
+        }
+        return static_cast<int>((word << 6) + __builtin_ctzll(bits));
+    }
+
+    bool empty() const {
+        for (uint64_t word : words_) {
+            if (word) return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+#endif // ACTIVE_NODE_SET_H
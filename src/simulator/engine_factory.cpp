@@ -0,0 +1,130 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "simulator/engine_factory.h"
+#include "simulator/simulator_core.h"
+#include "network/hypercube_network.h"
+#include "network/topology_policies.h"
+#include "routing/dimension_order_routing.h"
+#include "routing/duato_routing.h"
+#include "routing/table_routing.h"
+#include "traffic/uniform_traffic_policies.h"
+#include "utils/config.h"
+#include <stdexcept>
+#include <mutex>
+#include <iostream>
+
+using HypercubeEcubeEngine = SimulatorCore<HypercubeTopology, DimensionOrderRouting, CounterUniformTraffic>;
+using HypercubeDuatoEngine = SimulatorCore<HypercubeTopology, DuatoRouting, CounterUniformTraffic>;
+using MeshDuatoEngine = SimulatorCore<MeshTopology, DuatoRouting, CounterUniformTraffic>;
+using MeshTableEngine = SimulatorCore<MeshTopology, TableRouting, CounterUniformTraffic>;
+
+namespace {
+
+// Meshes read Duato's decisions from the compiled table when there is one
+std::unique_ptr<SimulatorEngine> createMeshEngine(const MeshTopology& topology,
+                                                  const std::shared_ptr<const CompiledRoutingTable>& routingTable,
+                                                  const std::shared_ptr<const TrafficPattern>& trafficPattern) {
+    if (routingTable) {
+        return std::unique_ptr<SimulatorEngine>(
+            new MeshTableEngine(topology, TableRouting(routingTable), CounterUniformTraffic(trafficPattern)));
+    }
+    return std::unique_ptr<SimulatorEngine>(
+        new MeshDuatoEngine(topology, DuatoRouting(), CounterUniformTraffic(trafficPattern)));
+}
+
+} // namespace
+
+EngineFactory& EngineFactory::getInstance() {
+    static EngineFactory instance;
+    static std::once_flag initialized;
+
+    // Sweep workers may reach the factory concurrently
+    std::call_once(initialized, [] { instance.initializeBuiltinEngines(); });
+
+    return instance;
+}
+
+void EngineFactory::registerEngine(const std::string& algorithmName, const std::string& topologyName,
+                                   EngineCreator creator) {
+    creators_[makeKey(algorithmName, topologyName)] = creator;
+    algorithmsByTopology_[topologyName].push_back(algorithmName);
+    std::cout << "Registered simulation engine: " << algorithmName << " for topology: " << topologyName << std::endl;
+}
+
+std::unique_ptr<SimulatorEngine> EngineFactory::createEngine(const Network* network, const Config& config,
+                                                             const std::shared_ptr<const CompiledRoutingTable>& routingTable,
+                                                             const std::shared_ptr<const TrafficPattern>& trafficPattern) {
+    const std::string& topology = config.getNetworkTopology();
+    const std::string algorithm = config.getRoutingAlgorithm();
+
+    auto it = creators_.find(makeKey(algorithm, topology));
+    if (it == creators_.end()) {
+        auto registered = algorithmsByTopology_.find(topology);
+        if (registered == algorithmsByTopology_.end()) {
+            throw std::invalid_argument("No simulation engine for topology: " + topology);
+        }
+        std::string supported;
+        for (const std::string& name : registered->second) {
+            supported += (supported.empty() ? "" : ", ") + name;
+        }
+        throw std::invalid_argument("No simulation engine for routing algorithm '" + algorithm + "' on topology " +
+                                    topology + ". Supported algorithms: " + supported);
+    }
+
+    return it->second(network, config, routingTable, trafficPattern);
+}
+
+bool EngineFactory::isTopologySupported(const std::string& topologyName) const {
+    return algorithmsByTopology_.find(topologyName) != algorithmsByTopology_.end();
+}
+
+std::string EngineFactory::makeKey(const std::string& algorithm, const std::string& topology) const {
+    return algorithm + "_" + topology;
+}
+
+void EngineFactory::initializeBuiltinEngines() {
+    registerEngine("ecube", "hypercube", [](const Network* network, const Config& /*config*/,
+           const std::shared_ptr<const CompiledRoutingTable>& /*routingTable*/,
+           const std::shared_ptr<const TrafficPattern>& trafficPattern) -> std::unique_ptr<SimulatorEngine> {
+        const HypercubeNetwork* hypercubeNet = dynamic_cast<const HypercubeNetwork*>(network);
+        if (!hypercubeNet) {
+            throw std::invalid_argument("Hypercube engine requires HypercubeNetwork");
+        }
+        return std::unique_ptr<SimulatorEngine>(
+            new HypercubeEcubeEngine(HypercubeTopology(hypercubeNet->getDimension()), DimensionOrderRouting(),
+                                     CounterUniformTraffic(trafficPattern)));
+    });
+
+    registerEngine("duato", "hypercube", [](const Network* network, const Config& /*config*/,
+           const std::shared_ptr<const CompiledRoutingTable>& /*routingTable*/,
+           const std::shared_ptr<const TrafficPattern>& trafficPattern) -> std::unique_ptr<SimulatorEngine> {
+        const HypercubeNetwork* hypercubeNet = dynamic_cast<const HypercubeNetwork*>(network);
+        if (!hypercubeNet) {
+            throw std::invalid_argument("Hypercube engine requires HypercubeNetwork");
+        }
+        return std::unique_ptr<SimulatorEngine>(
+            new HypercubeDuatoEngine(HypercubeTopology(hypercubeNet->getDimension()), DuatoRouting(),
+                                     CounterUniformTraffic(trafficPattern)));
+    });
+
+    registerEngine("duato", "2D_mesh", [](const Network* /*network*/, const Config& config,
+           const std::shared_ptr<const CompiledRoutingTable>& routingTable,
+           const std::shared_ptr<const TrafficPattern>& trafficPattern) -> std::unique_ptr<SimulatorEngine> {
+        auto size = config.getNetworkSize2D();
+        return createMeshEngine(MeshTopology(size[0], size[1]), routingTable, trafficPattern);
+    });
+
+    // Matches the placeholder 2D network built for "3D_mesh"
+    registerEngine("duato", "3D_mesh", [](const Network* /*network*/, const Config& config,
+           const std::shared_ptr<const CompiledRoutingTable>& routingTable,
+           const std::shared_ptr<const TrafficPattern>& trafficPattern) -> std::unique_ptr<SimulatorEngine> {
+        auto size = config.getNetworkSize3D();
+        return createMeshEngine(MeshTopology(size[0] * size[1], size[2]), routingTable, trafficPattern);
+    });
+}
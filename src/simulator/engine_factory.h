@@ -0,0 +1,92 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef ENGINE_FACTORY_H
+#define ENGINE_FACTORY_H
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class SimulatorEngine;
+class Network;
+class CompiledRoutingTable;
+class TrafficPattern;
+class Config;
+
+/**
+ * @brief Factory for compiled simulation engines
+ *
+ * Each (routing algorithm, topology) pair registers a creator that
+ * instantiates SimulatorCore with the matching topology, routing and
+ * traffic policies, so the choice of template instantiation is made once
+ * when the simulation is set up. An algorithm with no engine for the
+ * topology is an error rather than a silent substitution.
+ */
+class EngineFactory {
+public:
+    // Type alias for engine creator function
+    using EngineCreator = std::function<std::unique_ptr<SimulatorEngine>(
+        const Network*, const Config&, const std::shared_ptr<const CompiledRoutingTable>&,
+        const std::shared_ptr<const TrafficPattern>&)>;
+
+    /**
+     * @brief Get the singleton instance of EngineFactory
+     */
+    static EngineFactory& getInstance();
+
+    /**
+     * @brief Register an engine for a routing algorithm on a network topology
+     * @param algorithmName The name of the routing algorithm (e.g., "duato", "ecube")
+     * @param topologyName The name of the topology (e.g., "2D_mesh", "hypercube")
+     * @param creator Function that creates the engine instance
+     */
+    void registerEngine(const std::string& algorithmName, const std::string& topologyName,
+                        EngineCreator creator);
+
+    /**
+     * @brief Create the engine for the configured algorithm and topology
+     * @param network The network instance built for this configuration
+     * @param config Configuration object
+     * @param routingTable Compiled routing decisions, or null where the engine computes them
+     * @param trafficPattern Destinations of injected packets, or null for uniform traffic
+     * @return Unique pointer to the created engine
+     * @throws std::invalid_argument if no engine is registered for the algorithm on the topology
+     */
+    std::unique_ptr<SimulatorEngine> createEngine(const Network* network, const Config& config,
+                                                  const std::shared_ptr<const CompiledRoutingTable>& routingTable,
+                                                  const std::shared_ptr<const TrafficPattern>& trafficPattern);
+
+    /**
+     * @brief Check if an engine is registered for a topology
+     * @param topologyName Name of the topology to check
+     * @return True if supported, false otherwise
+     */
+    bool isTopologySupported(const std::string& topologyName) const;
+
+private:
+    EngineFactory() = default;
+    ~EngineFactory() = default;
+    EngineFactory(const EngineFactory&) = delete;
+    EngineFactory& operator=(const EngineFactory&) = delete;
+
+    // Registry of engine creators keyed by "algorithm_topology"
+    std::unordered_map<std::string, EngineCreator> creators_;
+
+    // Registered algorithm names per topology, for error messages
+    std::unordered_map<std::string, std::vector<std::string>> algorithmsByTopology_;
+
+    std::string makeKey(const std::string& algorithm, const std::string& topology) const;
+
+    // Initialize built-in engines
+    void initializeBuiltinEngines();
+};
+
+#endif // ENGINE_FACTORY_H
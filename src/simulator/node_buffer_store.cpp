@@ -0,0 +1,136 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "simulator/node_buffer_store.h"
+#include <algorithm>
+
+const int NodeBufferStore::kBlockPackets;
+
+NodeBufferStore::NodeBufferStore() : strideShift_(0), mask_(0), totalSize_(0), freeBlock_(-1), overflowSize_(0) {
+}
+
+void NodeBufferStore::initialize(int nodeCount, int capacity) {
+    strideShift_ = 0;
+    while ((1 << strideShift_) < std::max(1, capacity)) {
+        strideShift_++;
+    }
+    mask_ = (1 << strideShift_) - 1;
+
+    totalSize_ = 0;
+    counts_.assign(nodeCount, 0);
+    heads_.assign(nodeCount, 0);
+    slots_.assign(static_cast<size_t>(nodeCount) << strideShift_, PacketPool::kInvalidHandle);
+    activeNodes_.resize(nodeCount);
+
+    overflowHeads_.assign(nodeCount, -1);
+    overflowTails_.assign(nodeCount, -1);
+    overflowBegins_.assign(nodeCount, 0);
+    overflowEnds_.assign(nodeCount, 0);
+    overflowBlocks_.clear();
+    freeBlock_ = -1;
+    overflowSize_ = 0;
+}
+
+void NodeBufferStore::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    std::fill(heads_.begin(), heads_.end(), 0);
+    activeNodes_.clear();
+    totalSize_ = 0;
+
+    // Keep the pool's storage for the next run; every block becomes free
+    std::fill(overflowHeads_.begin(), overflowHeads_.end(), -1);
+    std::fill(overflowTails_.begin(), overflowTails_.end(), -1);
+    freeBlock_ = -1;
+    for (int block = static_cast<int>(overflowBlocks_.size()) - 1; block >= 0; --block) {
+        overflowBlocks_[block].next = freeBlock_;
+        freeBlock_ = block;
+    }
+    overflowSize_ = 0;
+}
+
+int NodeBufferStore::allocateBlock() {
+    int block = freeBlock_;
+    if (block >= 0) {
+        freeBlock_ = overflowBlocks_[block].next;
+    } else {
+        block = static_cast<int>(overflowBlocks_.size());
+        overflowBlocks_.push_back(OverflowBlock());
+    }
+    overflowBlocks_[block].previous = -1;
+    overflowBlocks_[block].next = -1;
+    return block;
+}
+
+void NodeBufferStore::releaseBlock(int block) {
+    overflowBlocks_[block].next = freeBlock_;
+    freeBlock_ = block;
+}
+
+void NodeBufferStore::appendOverflow(int node, PacketHandle packet) {
+    if (overflowTails_[node] < 0) {
+        int block = allocateBlock();
+        overflowHeads_[node] = overflowTails_[node] = block;
+        overflowBegins_[node] = overflowEnds_[node] = 0;
+    } else if (overflowEnds_[node] == kBlockPackets) {
+        int block = allocateBlock();
+        overflowBlocks_[overflowTails_[node]].next = block;
+        overflowBlocks_[block].previous = overflowTails_[node];
+        overflowTails_[node] = block;
+        overflowEnds_[node] = 0;
+    }
+    overflowBlocks_[overflowTails_[node]].packets[overflowEnds_[node]++] = packet;
+    overflowSize_++;
+}
+
+void NodeBufferStore::prependOverflow(int node, PacketHandle packet) {
+    if (overflowHeads_[node] < 0) {
+        int block = allocateBlock();
+        overflowHeads_[node] = overflowTails_[node] = block;
+        overflowBegins_[node] = overflowEnds_[node] = kBlockPackets;
+    } else if (overflowBegins_[node] == 0) {
+        int block = allocateBlock();
+        overflowBlocks_[overflowHeads_[node]].previous = block;
+        overflowBlocks_[block].next = overflowHeads_[node];
+        overflowHeads_[node] = block;
+        overflowBegins_[node] = kBlockPackets;
+    }
+    overflowBlocks_[overflowHeads_[node]].packets[--overflowBegins_[node]] = packet;
+    overflowSize_++;
+}
+
+PacketHandle NodeBufferStore::takeOverflowFront(int node) {
+    int head = overflowHeads_[node];
+    PacketHandle packet = overflowBlocks_[head].packets[overflowBegins_[node]++];
+    if (head == overflowTails_[node] && overflowBegins_[node] == overflowEnds_[node]) {
+        releaseBlock(head);
+        overflowHeads_[node] = overflowTails_[node] = -1;
+    } else if (overflowBegins_[node] == kBlockPackets) {
+        overflowHeads_[node] = overflowBlocks_[head].next;
+        overflowBlocks_[overflowHeads_[node]].previous = -1;
+        overflowBegins_[node] = 0;
+        releaseBlock(head);
+    }
+    overflowSize_--;
+    return packet;
+}
+
+PacketHandle NodeBufferStore::takeOverflowBack(int node) {
+    int tail = overflowTails_[node];
+    PacketHandle packet = overflowBlocks_[tail].packets[--overflowEnds_[node]];
+    if (tail == overflowHeads_[node] && overflowBegins_[node] == overflowEnds_[node]) {
+        releaseBlock(tail);
+        overflowHeads_[node] = overflowTails_[node] = -1;
+    } else if (overflowEnds_[node] == 0) {
+        overflowTails_[node] = overflowBlocks_[tail].previous;
+        overflowBlocks_[overflowTails_[node]].next = -1;
+        overflowEnds_[node] = kBlockPackets;
+        releaseBlock(tail);
+    }
+    overflowSize_--;
+    return packet;
+}
@@ -0,0 +1,170 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef NODE_BUFFER_STORE_H
+#define NODE_BUFFER_STORE_H
+
+#include "message/packet_pool.h"
+#include "simulator/active_node_set.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Dense per-node router buffers indexed by node id
+ *
+ * Every node owns a fixed power-of-two ring inside one contiguous slot
+ * array sized from the router buffer capacity, so buffer lookups are plain
+ * array indexing instead of map walks and the slab never reallocates.
+ * Routing never fills a ring past that capacity, but source injection is
+ * not throttled: packets pushed onto a full ring wait in the node's
+ * overflow chain, and each pop refills the ring from it in order. Chains
+ * are linked cache-line blocks from one shared pool with a free list, so
+ * their memory follows the packets actually waiting (about 4.6 bytes
+ * each) rather than the busiest node's backlog times the node count.
+ *
+ * The store also keeps the set of non-empty nodes and the total number
+ * of buffered packets up to date on every push and pop, so routing can
+ * visit only nodes that hold packets and occupancy queries are O(1).
+ */
+class NodeBufferStore {
+public:
+    NodeBufferStore();
+
+    /**
+     * @brief Allocate buffers for a network
+     * @param nodeCount Number of nodes (valid ids are 0..nodeCount-1)
+     * @param capacity Router buffer capacity in packets
+     */
+    void initialize(int nodeCount, int capacity);
+
+    int getNodeCount() const { return static_cast<int>(counts_.size()); }
+
+    bool empty(int node) const { return counts_[node] == 0; }
+    int size(int node) const { return counts_[node]; }
+
+    /**
+     * @brief Packets buffered across all nodes
+     */
+    long long totalSize() const { return totalSize_; }
+
+    /**
+     * @brief Packets waiting in overflow chains across all nodes
+     */
+    size_t overflowSize() const { return overflowSize_; }
+
+    PacketHandle front(int node) const {
+        return slots_[(static_cast<size_t>(node) << strideShift_) + heads_[node]];
+    }
+
+    void push(int node, PacketHandle packet) {
+        if (counts_[node] > mask_) {
+            appendOverflow(node, packet);
+        } else {
+            int tail = (heads_[node] + counts_[node]) & mask_;
+            slots_[(static_cast<size_t>(node) << strideShift_) + tail] = packet;
+        }
+        if (counts_[node]++ == 0) {
+            activeNodes_.insert(node);
+        }
+        totalSize_++;
+    }
+
+    PacketHandle pop(int node) {
+        PacketHandle packet = front(node);
+        heads_[node] = (heads_[node] + 1) & mask_;
+        if (overflowHeads_[node] >= 0) {
+            // The freed slot is the ring's new tail
+            int tail = (heads_[node] + mask_) & mask_;
+            slots_[(static_cast<size_t>(node) << strideShift_) + tail] = takeOverflowFront(node);
+        }
+        if (--counts_[node] == 0) {
+            activeNodes_.erase(node);
+        }
+        totalSize_--;
+        return packet;
+    }
+
+    /**
+     * @brief Put a popped packet back at the head (undoes pop)
+     */
+    void pushFront(int node, PacketHandle packet) {
+        if (counts_[node] > mask_) {
+            int tail = (heads_[node] + mask_) & mask_;
+            prependOverflow(node, slots_[(static_cast<size_t>(node) << strideShift_) + tail]);
+        }
+        heads_[node] = (heads_[node] - 1) & mask_;
+        slots_[(static_cast<size_t>(node) << strideShift_) + heads_[node]] = packet;
+        if (counts_[node]++ == 0) {
+            activeNodes_.insert(node);
+        }
+        totalSize_++;
+    }
+
+    /**
+     * @brief Remove the most recently pushed packet (undoes push)
+     */
+    PacketHandle popBack(int node) {
+        PacketHandle packet;
+        if (overflowTails_[node] >= 0) {
+            packet = takeOverflowBack(node);
+        } else {
+            int tail = (heads_[node] + counts_[node] - 1) & mask_;
+            packet = slots_[(static_cast<size_t>(node) << strideShift_) + tail];
+        }
+        if (--counts_[node] == 0) {
+            activeNodes_.erase(node);
+        }
+        totalSize_--;
+        return packet;
+    }
+
+    const ActiveNodeSet& getActiveNodes() const { return activeNodes_; }
+
+    /**
+     * @brief Empty all rings and overflow chains (the records belong to the PacketPool)
+     */
+    void clear();
+
+private:
+    static const int kBlockPackets = 14;
+
+    // One cache line: fourteen handles and the chain links
+    struct OverflowBlock {
+        PacketHandle packets[kBlockPackets];
+        int previous;
+        int next;
+    };
+
+    int allocateBlock();
+    void releaseBlock(int block);
+    void appendOverflow(int node, PacketHandle packet);
+    void prependOverflow(int node, PacketHandle packet);
+    PacketHandle takeOverflowFront(int node);
+    PacketHandle takeOverflowBack(int node);
+
+    int strideShift_;
+    int mask_;
+    long long totalSize_;
+    std::vector<int> counts_;  // Ring plus overflow
+    std::vector<int> heads_;
+    std::vector<PacketHandle> slots_;
+    ActiveNodeSet activeNodes_;
+
+    // Overflow chains: doubly linked blocks, -1 terminated; a node has one
+    // only while its ring is full. Packets run from overflowBegins_ in the
+    // head block to just before overflowEnds_ in the tail block.
+    std::vector<int> overflowHeads_;
+    std::vector<int> overflowTails_;
+    std::vector<int> overflowBegins_;
+    std::vector<int> overflowEnds_;
+    std::vector<OverflowBlock> overflowBlocks_;
+    int freeBlock_;
+    size_t overflowSize_;
+};
+
+#endif // NODE_BUFFER_STORE_H
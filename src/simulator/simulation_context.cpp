@@ -7,20 +7,26 @@
  */
 
 #include "simulation_context.h"
-#include "../network/network_factory.h"
-#include "../routing/routing_factory.h"
+#include "simulation_topology.h"
+#include "engine_factory.h"
 #include "../network/network.h"
 #include "../network/hypercube_network.h"
 #include "../routing/routing_algorithm.h"
+#include "../routing/compiled_routing_table.h"
 #include "../utils/config.h"
 #include "simulator.h"
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 SimulationContext::SimulationContext(const Config& config)
     : config_(config), initialized_(false), descriptionsGenerated_(false) {
 }
 
+SimulationContext::SimulationContext(const Config& config, std::shared_ptr<const SimulationTopology> topology)
+    : config_(config), topology_(std::move(topology)), initialized_(false), descriptionsGenerated_(false) {
+}
+
 SimulationContext::~SimulationContext() = default;
 
 void SimulationContext::initialize() {
@@ -31,9 +37,10 @@ void SimulationContext::initialize() {
     try {
         std::cout << "Initializing simulation context..." << std::endl;
         
-        // Create components in the correct order
-        createNetwork();
-        createRoutingAlgorithm();
+        // Network and routing first, unless another context already built them
+        if (!topology_) {
+            topology_ = SimulationTopology::build(config_);
+        }
         createSimulator();
         
         initialized_ = true;
@@ -52,18 +59,32 @@ Simulator* SimulationContext::getSimulator() const {
     return simulator_.get();
 }
 
-Network* SimulationContext::getNetwork() const {
+const Network* SimulationContext::getNetwork() const {
+    if (!initialized_) {
+        throw std::runtime_error("Simulation context not initialized");
+    }
+    return topology_->getNetwork();
+}
+
+const RoutingAlgorithm* SimulationContext::getRoutingAlgorithm() const {
     if (!initialized_) {
         throw std::runtime_error("Simulation context not initialized");
     }
-    return network_.get();
+    return topology_->getRoutingAlgorithm();
 }
 
-RoutingAlgorithm* SimulationContext::getRoutingAlgorithm() const {
+std::shared_ptr<const CompiledRoutingTable> SimulationContext::getRoutingTable() const {
     if (!initialized_) {
         throw std::runtime_error("Simulation context not initialized");
     }
-    return routingAlgorithm_.get();
+    return topology_->getRoutingTable();
+}
+
+std::shared_ptr<const SimulationTopology> SimulationContext::getTopology() const {
+    if (!initialized_) {
+        throw std::runtime_error("Simulation context not initialized");
+    }
+    return topology_;
 }
 
 const Config& SimulationContext::getConfig() const {
@@ -111,48 +132,14 @@ void SimulationContext::printSetupInfo() const {
     std::cout << std::string(80, '=') << std::endl;
 }
 
-void SimulationContext::createNetwork() {
-    NetworkFactory& factory = NetworkFactory::getInstance();
-    
-    const std::string& topology = config_.getNetworkTopology();
-    if (!factory.isTopologySupported(topology)) {
-        throw std::invalid_argument("Unsupported network topology: " + topology);
-    }
-    
-    network_ = factory.createNetwork(config_);
-    if (!network_) {
-        throw std::runtime_error("Failed to create network instance");
-    }
-}
-
-void SimulationContext::createRoutingAlgorithm() {
-    RoutingFactory& factory = RoutingFactory::getInstance();
-    
-    routingAlgorithm_ = factory.createRoutingAlgorithm(network_.get(), config_);
-    if (!routingAlgorithm_) {
-        throw std::runtime_error("Failed to create routing algorithm instance");
-    }
-}
-
 void SimulationContext::createSimulator() {
-    // Check if we have a hypercube network
-    HypercubeNetwork* hypercubeNet = dynamic_cast<HypercubeNetwork*>(network_.get());
-    
-    if (hypercubeNet) {
-        // Use hypercube-specific constructor
-        simulator_ = std::unique_ptr<Simulator>(new Simulator(hypercubeNet));
-    } else {
-        // Assume 2D mesh network
-        auto size = config_.getNetworkSize2D();
-        simulator_ = std::unique_ptr<Simulator>(new Simulator(size[0], size[1]));
-        simulator_->setNetwork(network_.get());
-    }
-    
-    // Set the routing algorithm
-    simulator_->setRoutingAlgorithm(routingAlgorithm_.release());
+    // The engine factory picks the SimulatorCore instantiation for the topology
+    EngineFactory& factory = EngineFactory::getInstance();
     
-    // Initialize the simulator
-    simulator_->initializeNetwork();
+    simulator_ = std::unique_ptr<Simulator>(new Simulator(
+        factory.createEngine(topology_->getNetwork(), config_, topology_->getRoutingTable(),
+                             topology_->getTrafficPattern()),
+        topology_));
 }
 
 void SimulationContext::generateDescriptions() const {
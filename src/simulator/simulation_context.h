@@ -19,6 +19,8 @@ class TrafficPattern;
 class Simulator;
 class Config;
 class HypercubeNetwork;
+class CompiledRoutingTable;
+class SimulationTopology;
 
 /**
  * @brief Simulation context that encapsulates all simulation components
@@ -26,6 +28,9 @@ class HypercubeNetwork;
  * This class provides a high-level interface for setting up and managing
  * a simulation. It follows the facade pattern to hide the complexity of
  * component interaction and factory-based creation.
+ *
+ * The network and routing data live in a SimulationTopology that several
+ * contexts may share; each context owns only its simulator and engine.
  */
 class SimulationContext {
 public:
@@ -35,6 +40,13 @@ public:
      */
     explicit SimulationContext(const Config& config);
     
+    /**
+     * @brief Create a simulation context over an already built topology
+     * @param config Configuration object the topology was built from
+     * @param topology Shared network and routing data
+     */
+    SimulationContext(const Config& config, std::shared_ptr<const SimulationTopology> topology);
+    
     /**
      * @brief Destructor
      */
@@ -43,8 +55,9 @@ public:
     /**
      * @brief Initialize the simulation context
      * 
-     * This method creates the network, routing algorithm, and simulator
-     * based on the configuration. It should be called after construction.
+     * This method creates the network and routing algorithm (unless a
+     * topology was supplied) and the simulator based on the configuration.
+     * It should be called after construction.
      */
     void initialize();
     
@@ -58,13 +71,25 @@ public:
      * @brief Get the network instance
      * @return Pointer to the network
      */
-    Network* getNetwork() const;
+    const Network* getNetwork() const;
     
     /**
      * @brief Get the routing algorithm instance
      * @return Pointer to the routing algorithm
      */
-    RoutingAlgorithm* getRoutingAlgorithm() const;
+    const RoutingAlgorithm* getRoutingAlgorithm() const;
+    
+    /**
+     * @brief Get the compiled routing table, if one was built
+     * @return Shared table, or null when the engine routes without one
+     */
+    std::shared_ptr<const CompiledRoutingTable> getRoutingTable() const;
+    
+    /**
+     * @brief Get the shared topology, to build more contexts over it
+     * @return Shared network and routing data
+     */
+    std::shared_ptr<const SimulationTopology> getTopology() const;
     
     /**
      * @brief Get the configuration
@@ -103,14 +128,11 @@ public:
     
 private:
     const Config& config_;
-    std::unique_ptr<Network> network_;
-    std::unique_ptr<RoutingAlgorithm> routingAlgorithm_;
+    std::shared_ptr<const SimulationTopology> topology_;
     std::unique_ptr<Simulator> simulator_;
     bool initialized_;
     
     // Helper methods
-    void createNetwork();
-    void createRoutingAlgorithm();
     void createSimulator();
     void setupNetworkDescription();
     void setupRoutingDescription();
@@ -0,0 +1,77 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "simulator/simulation_topology.h"
+#include "network/network.h"
+#include "network/network_factory.h"
+#include "routing/compiled_routing_table.h"
+#include "routing/routing_algorithm.h"
+#include "routing/routing_factory.h"
+#include "routing/routing_table_cache.h"
+#include "traffic/traffic_factory.h"
+#include "traffic/traffic_pattern.h"
+#include "utils/config.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+SimulationTopology::SimulationTopology() = default;
+
+SimulationTopology::~SimulationTopology() = default;
+
+std::shared_ptr<const SimulationTopology> SimulationTopology::build(const Config& config) {
+    std::shared_ptr<SimulationTopology> topology(new SimulationTopology());
+
+    NetworkFactory& networkFactory = NetworkFactory::getInstance();
+    const std::string& topologyName = config.getNetworkTopology();
+    if (!networkFactory.isTopologySupported(topologyName)) {
+        throw std::invalid_argument("Unsupported network topology: " + topologyName);
+    }
+    topology->network_ = networkFactory.createNetwork(config);
+    if (!topology->network_) {
+        throw std::runtime_error("Failed to create network instance");
+    }
+
+    topology->routingAlgorithm_ = RoutingFactory::getInstance().createRoutingAlgorithm(topology->network_.get(), config);
+    if (!topology->routingAlgorithm_) {
+        throw std::runtime_error("Failed to create routing algorithm instance");
+    }
+
+    // Hypercubes route on node-id bit operations, which beat any table
+    if (topologyName != "hypercube") {
+        const Network& network = *topology->network_;
+        std::string cacheDirectory = config.getTopologyCacheDirectory();
+        if (cacheDirectory.empty()) {
+            topology->routingTable_ = CompiledRoutingTable::compile(*topology->routingAlgorithm_, network.getWidth(),
+                                                                    network.getHeight());
+        } else {
+            // Everything the candidates depend on
+            std::string key = "topology=" + topologyName +
+                              " width=" + std::to_string(network.getWidth()) +
+                              " height=" + std::to_string(network.getHeight()) +
+                              " algorithm=" + config.getRoutingAlgorithm() +
+                              " dense_limit=" + std::to_string(CompiledRoutingTable::kDefaultDenseLimitBytes);
+            topology->routingTable_ = RoutingTableCache(cacheDirectory).findOrCompile(
+                key, *topology->routingAlgorithm_, network.getWidth(), network.getHeight());
+        }
+    }
+
+    // Pattern shapes are radices of the engine's node ids, lowest digit first;
+    // hypercube patterns see one ring. Mesh engines number nodes x * height + y
+    // (MeshTopology), so y is the low digit.
+    std::vector<int> radices;
+    if (topologyName == "hypercube") {
+        radices.push_back(1 << config.getHypercubeDimension());
+    } else {
+        radices.push_back(topology->network_->getHeight());
+        radices.push_back(topology->network_->getWidth());
+    }
+    topology->trafficPattern_ = TrafficFactory::getInstance().createPattern(config, radices);
+
+    return topology;
+}
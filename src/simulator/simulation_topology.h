@@ -0,0 +1,60 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef SIMULATION_TOPOLOGY_H
+#define SIMULATION_TOPOLOGY_H
+
+#include <memory>
+
+class Network;
+class RoutingAlgorithm;
+class CompiledRoutingTable;
+class TrafficPattern;
+class Config;
+
+/**
+ * @brief Network, routing and traffic data shared by every simulator of a sweep
+ *
+ * Built once per configuration and never modified afterwards, so any
+ * number of SimulationContexts on different threads can hold it through
+ * a shared_ptr<const SimulationTopology> and read it without locking.
+ * Per-run state (buffers, packets, metrics) lives in each context's
+ * engine; the last context to let go frees the topology.
+ */
+class SimulationTopology {
+public:
+    /**
+     * @brief Build the network, routing algorithm, compiled table and traffic pattern for a configuration
+     * @throws std::invalid_argument if the topology, algorithm or traffic pattern is unsupported
+     */
+    static std::shared_ptr<const SimulationTopology> build(const Config& config);
+
+    ~SimulationTopology();
+
+    const Network* getNetwork() const { return network_.get(); }
+    const RoutingAlgorithm* getRoutingAlgorithm() const { return routingAlgorithm_.get(); }
+
+    /**
+     * @brief Compiled routing decisions, or null where the engine computes them
+     */
+    std::shared_ptr<const CompiledRoutingTable> getRoutingTable() const { return routingTable_; }
+
+    std::shared_ptr<const TrafficPattern> getTrafficPattern() const { return trafficPattern_; }
+
+private:
+    SimulationTopology();
+    SimulationTopology(const SimulationTopology&) = delete;
+    SimulationTopology& operator=(const SimulationTopology&) = delete;
+
+    std::unique_ptr<Network> network_;
+    std::unique_ptr<RoutingAlgorithm> routingAlgorithm_;
+    std::shared_ptr<const CompiledRoutingTable> routingTable_;
+    std::shared_ptr<const TrafficPattern> trafficPattern_;
+};
+
+#endif // SIMULATION_TOPOLOGY_H
@@ -11,26 +11,33 @@
 
 #include "network/network.h"
 #include "routing/routing_algorithm.h"
-#include "traffic/traffic_pattern.h"
 #include "metrics/metrics.h"
-#include <vector>
-#include <map>
-#include <queue>
+#include "simulator/simulator_engine.h"
+#include <memory>
 
 // Forward declarations
 class Config;
-class Packet;
-class Node;
 class HypercubeNetwork;
-
+class SimulationTopology;
+
+/**
+ * @brief Simulation front end over a compiled SimulatorEngine
+ *
+ * The cycle loop lives in SimulatorCore; this class keeps the network and
+ * routing algorithm ownership rules and forwards runs to the engine. A
+ * simulator built over a shared SimulationTopology keeps it alive but
+ * never owns or modifies it.
+ */
 class Simulator {
 public:
     Simulator(int networkSizeX, int networkSizeY);
     Simulator(HypercubeNetwork* hypercubeNetwork);
+    Simulator(std::unique_ptr<SimulatorEngine> engine, std::shared_ptr<const SimulationTopology> topology);
     ~Simulator();
     
     void initializeNetwork();
     void runSimulation(double injectionRate, const Config& config);
+    void setSeed(unsigned seed);
     void collectMetrics();
     Metrics* getMetrics() const;
     void reset();
@@ -39,49 +46,11 @@ public:
     void setRoutingAlgorithm(RoutingAlgorithm* algorithm);
 
 private:
-    int injectPackets(double injectionRate);
-    void routePackets();
-    int receivePackets();
-    void updateCurrentCycle(int cycle);
-    
-    double getNodeBufferUtilization(Node* node);
-    int calculateCongestionDelay(Node* source, Node* destination);
-    double calculateNetworkUtilization();
-    void updateNetworkState();
-    
-    Node* calculateNextHop(Node* current, Node* destination);
-    Node* calculateNextHopHypercube(Node* current, Node* destination);
-    int countReceivedFlits();
-    double calculateQueuingDelay(Packet* packet);
-    double calculateBufferDelay(Packet* packet);
-
-    int networkSizeX;
-    int networkSizeY;
-    int currentCycle;
-    int maxBufferSize;
-    double linkCapacity;
-    bool isHypercubeMode;      
-    HypercubeNetwork* hypercubeNet;
-    
     Network* network;
+    bool ownsNetwork;
     RoutingAlgorithm* routingAlgorithm;
-    TrafficPattern* trafficPattern;
-    Metrics* metrics;
-    
-    std::map<Node*, std::queue<Packet*>> nodeBuffers;
-    std::map<std::pair<Node*, Node*>, int> linkUtilization;
-    
-    struct InTransitPacket {
-        Packet* packetPtr;
-        int arrivalCycle;
-        Node* destinationNode;
-        
-        InTransitPacket(Packet* packet, int cycle, Node* dest) 
-            : packetPtr(packet), arrivalCycle(cycle), destinationNode(dest) {}
-    };
-    
-    std::vector<InTransitPacket> inTransitPackets;
-    double currentInjectionRate;
+    std::shared_ptr<const SimulationTopology> topology;
+    std::unique_ptr<SimulatorEngine> engine;
 };
 
-#endif // SIMULATOR_H
\ No newline at end of file
+#endif // SIMULATOR_H
@@ -0,0 +1,524 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef SIMULATOR_CORE_TIME_WARP_H
+#define SIMULATOR_CORE_TIME_WARP_H
+
+// Optimistic ("timewarp") engine of SimulatorCore; included at the end of
+// simulator_core.h, which declares the members defined here.
+//
+// Each partition becomes a logical process (LP) whose virtual time is the
+// window. A window only reads what the LP's peers sent in the previous
+// one: hop requests, grants and the occupancy of nodes the LP routes into,
+// which travel together as one message per peer and window. An LP runs a
+// window as soon as it is scheduled, taking a peer it has not heard from
+// to have sent nothing. When a peer later sends something different for a
+// window the LP has already read, the LP rolls back to the window that
+// read it and runs forward again.
+//
+// State is saved by copying the partition every few windows; a rollback
+// restores the latest copy before the straggler and re-runs the windows in
+// between from the messages it kept. The occupancy view is restored from a
+// log of the values each window's messages overwrote. Cancellation is lazy:
+// a re-run window resends a message only if its content changed, so a
+// rollback only spreads to peers whose inputs it actually alters.
+// Injections draw from the counter-based traffic stream at (node, cycle),
+// so there is no RNG state to save.
+//
+// GVT, the earliest window any LP may still change, is the minimum over
+// LPs of their virtual time and pending rollbacks. Any thread recomputes it
+// after a window without stopping the others, and retries if a rollback
+// was flagged while it read. Windows before GVT are committed in window
+// order through the same recording as the other engines, so the results
+// equal theirs on any number of threads. optimism_window bounds how many
+// cycles an LP may run past GVT, which bounds saved state.
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+template <typename Topology, typename Routing, typename Traffic>
+struct SimulatorCore<Topology, Routing, Traffic>::TimeWarpMessage {
+    Mailbox mailbox;
+    std::vector<std::pair<int, uint8_t>> occupancy;   // Published occupancy by node id
+
+    static bool samePacket(const PacketRecord& a, const PacketRecord& b) {
+        return a.sourceId == b.sourceId && a.destinationId == b.destinationId && a.currentId == b.currentId &&
+               a.injectionCycle == b.injectionCycle && a.hopCount == b.hopCount &&
+               a.adaptivePorts == b.adaptivePorts && a.escapePorts == b.escapePorts && a.channel == b.channel;
+    }
+
+    // A missing message stands for an empty one
+    static bool same(const TimeWarpMessage* a, const TimeWarpMessage* b) {
+        if (a == nullptr || b == nullptr) {
+            return a == b;
+        }
+        if (a->mailbox.requests.size() != b->mailbox.requests.size() ||
+            a->mailbox.grants.size() != b->mailbox.grants.size() || a->occupancy != b->occupancy) {
+            return false;
+        }
+        for (size_t i = 0; i < a->mailbox.requests.size(); ++i) {
+            const HopRequest& x = a->mailbox.requests[i];
+            const HopRequest& y = b->mailbox.requests[i];
+            if (x.dueCycle != y.dueCycle || x.senderId != y.senderId || x.targetId != y.targetId ||
+                x.round != y.round || x.port != y.port || x.channel != y.channel ||
+                x.firstUseOfLink != y.firstUseOfLink || !samePacket(x.packet, y.packet)) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < a->mailbox.grants.size(); ++i) {
+            const HopGrant& x = a->mailbox.grants[i];
+            const HopGrant& y = b->mailbox.grants[i];
+            if (x.dueCycle != y.dueCycle || x.senderId != y.senderId || x.round != y.round) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template <typename Topology, typename Routing, typename Traffic>
+struct SimulatorCore<Topology, Routing, Traffic>::LogicalProcess {
+    using MessagePtr = std::shared_ptr<const TimeWarpMessage>;
+
+    struct Checkpoint {
+        int window;
+        Partition state;
+    };
+
+    // Owned by the LP's thread
+    Partition* partition;                    // Live state, one of partitions_
+    std::vector<int> peers;                  // Partitions this one exchanges messages with, itself included
+    std::vector<int> slotAtPeer;             // This LP's index in each peer's peers
+    std::vector<std::vector<uint16_t>> readers;   // Peer slots that route into each node, by id - begin
+    std::vector<uint8_t> view;               // Occupancy by node id as of the end of the previous window
+    std::deque<std::vector<std::pair<int, uint8_t>>> viewUndo;   // Values each window's inputs overwrote
+    int viewUndoBase;
+    std::deque<Checkpoint> checkpoints;
+    std::deque<std::vector<MessagePtr>> sent;     // By window, then peer slot
+    int sentBase;
+    std::vector<MessagePtr> inputs;          // The running window's messages, by peer slot
+    std::vector<std::vector<std::pair<int, uint8_t>>> updates;   // Changed occupancy by peer slot
+    Mailbox noMessages;
+    int nextWindow;
+    long long executedWindows;
+    long long rolledBackWindows;
+    long long rollbacks;
+
+    // Shared with peers and the committing thread, under lock
+    std::mutex lock;
+    std::deque<std::vector<MessagePtr>> received;  // By window sent, then peer slot
+    int receivedBase;
+    int inputsRead;                          // Last window whose inputs were read
+    int coastTarget;                         // Windows before it re-run unchanged after a rollback
+    std::deque<WindowResults> results;       // By window, until committed
+    int resultsBase;
+    std::atomic<int> virtualTime;            // Earliest window whose outputs may still change
+    std::atomic<int> pendingRollback;        // Earliest window a peer invalidated, or INT_MAX
+};
+
+template <typename Topology, typename Routing, typename Traffic>
+struct SimulatorCore<Topology, Routing, Traffic>::TimeWarpClock {
+    EngineClock engine;                      // Committed progress, under commitLock
+    int windowCount;
+    int optimismWindows;
+    std::atomic<int> gvt;
+    std::atomic<long long> rollbackEpoch;    // Bumped whenever a rollback is flagged
+    std::atomic<bool> finished;
+    std::mutex commitLock;
+};
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::runTimeWarp(double injectionRate, const Config& config,
+                                                            MeasurementCounters& counters) {
+    configurePartitions(config);
+
+    TimeWarpClock clock;
+    clock.engine = startRun(config, counters);
+    clock.windowCount = (std::max(0, clock.engine.endCycle) + linkLatencyCycles_ - 1) / linkLatencyCycles_;
+    clock.optimismWindows = std::max(1, (config.getOptimismWindowCycles() + linkLatencyCycles_ - 1) /
+                                            linkLatencyCycles_);
+    clock.gvt.store(0);
+    clock.rollbackEpoch.store(0);
+    clock.finished.store(clock.engine.finished);
+
+    setupLogicalProcesses();
+
+    auto inject = [this, injectionRate](Partition& partition, int cycle) {
+        forEachInjection(partition.begin, partition.end, cycle, injectionRate,
+                         [this, &partition, cycle](int nodeId, int destinationId) {
+            createPacket(partition, nodeId, destinationId, cycle);
+        });
+    };
+
+    int processCount = static_cast<int>(logicalProcesses_.size());
+    int threadCount = std::min(engineThreads_, processCount);
+
+    std::vector<std::thread> team;
+    for (int thread = 1; thread < threadCount; ++thread) {
+        int first = processCount * thread / threadCount;
+        int last = processCount * (thread + 1) / threadCount;
+        team.emplace_back([this, first, last, &clock, &counters, &inject] {
+            runLogicalProcesses(first, last, clock, counters, inject);
+        });
+    }
+    runLogicalProcesses(0, processCount / threadCount, clock, counters, inject);
+    for (std::thread& thread : team) {
+        thread.join();
+    }
+
+    if (!clock.engine.measuring) {
+        metrics_.startMeasurement();
+    }
+
+    long long executedWindows = 0;
+    long long rolledBackWindows = 0;
+    long long rollbacks = 0;
+    for (auto& process : logicalProcesses_) {
+        executedWindows += process->executedWindows;
+        rolledBackWindows += process->rolledBackWindows;
+        rollbacks += process->rollbacks;
+    }
+
+    if (config.isPerformanceCountersEnabled() && executedWindows > 0) {
+        std::cout << "    Time Warp: " << executedWindows << " LP windows executed, " << rolledBackWindows
+                  << " rolled back in " << rollbacks << " rollbacks (efficiency "
+                  << 100.0 * (executedWindows - rolledBackWindows) / executedWindows << "%)" << std::endl;
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::setupLogicalProcesses() {
+    int processCount = static_cast<int>(partitions_.size());
+    int portCount = topology_.getPortCount();
+
+    // Peers and readers only depend on the partitioning
+    if (static_cast<int>(logicalProcesses_.size()) != processCount) {
+        logicalProcesses_.clear();
+        for (int index = 0; index < processCount; ++index) {
+            std::unique_ptr<LogicalProcess> process(new LogicalProcess());
+            Partition& partition = *partitions_[index];
+            process->partition = &partition;
+
+            std::vector<int> slotOf(processCount, -1);
+            slotOf[index] = 0;
+            process->peers.push_back(index);
+            process->readers.resize(partition.end - partition.begin);
+            for (int nodeId = partition.begin; nodeId < partition.end; ++nodeId) {
+                std::vector<uint16_t>& readers = process->readers[nodeId - partition.begin];
+                for (int port = 0; port < portCount; ++port) {
+                    int neighborId = topology_.neighborOnPort(nodeId, port);
+                    if (neighborId < 0 || neighborId >= nodeCount_) {
+                        continue;
+                    }
+                    int reader = nodePartition_[neighborId];
+                    if (slotOf[reader] < 0) {
+                        slotOf[reader] = static_cast<int>(process->peers.size());
+                        process->peers.push_back(reader);
+                    }
+                    uint16_t slot = static_cast<uint16_t>(slotOf[reader]);
+                    if (std::find(readers.begin(), readers.end(), slot) == readers.end()) {
+                        readers.push_back(slot);
+                    }
+                }
+            }
+            logicalProcesses_.push_back(std::move(process));
+        }
+
+        // Links run both ways, so peering is symmetric
+        for (auto& process : logicalProcesses_) {
+            for (int peer : process->peers) {
+                const std::vector<int>& theirs = logicalProcesses_[peer]->peers;
+                int slot = static_cast<int>(std::find(theirs.begin(), theirs.end(),
+                                                      process->partition->index) - theirs.begin());
+                process->slotAtPeer.push_back(slot);
+            }
+        }
+    }
+
+    for (auto& process : logicalProcesses_) {
+        size_t peerCount = process->peers.size();
+        process->view.assign(nodeCount_, 0);
+        process->viewUndo.clear();
+        process->viewUndoBase = 0;
+        process->checkpoints.clear();
+        process->sent.clear();
+        process->sentBase = 0;
+        process->inputs.assign(peerCount, nullptr);
+        process->updates.assign(peerCount, std::vector<std::pair<int, uint8_t>>());
+        process->nextWindow = 0;
+        process->coastTarget = 0;
+        process->executedWindows = 0;
+        process->rolledBackWindows = 0;
+        process->rollbacks = 0;
+        process->received.clear();
+        process->receivedBase = 0;
+        process->inputsRead = -1;
+        process->results.clear();
+        process->resultsBase = 0;
+        process->virtualTime.store(0);
+        process->pendingRollback.store(INT_MAX);
+
+        Partition& partition = *process->partition;
+        std::fill(partition.inboxes.begin(), partition.inboxes.end(), &process->noMessages);
+        partition.occupancyView = &process->view;
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+template <typename Inject>
+void SimulatorCore<Topology, Routing, Traffic>::runLogicalProcesses(int firstProcess, int lastProcess,
+                                                                    TimeWarpClock& clock,
+                                                                    MeasurementCounters& counters, Inject& inject) {
+    while (!clock.finished.load()) {
+        // Run the furthest-behind LP that is inside the optimism window
+        int limit = std::min(clock.windowCount, clock.gvt.load() + clock.optimismWindows);
+        LogicalProcess* next = nullptr;
+        for (int index = firstProcess; index < lastProcess; ++index) {
+            LogicalProcess& process = *logicalProcesses_[index];
+            rollback(process);
+            if (process.nextWindow < limit && (next == nullptr || process.nextWindow < next->nextWindow)) {
+                next = &process;
+            }
+        }
+
+        if (next != nullptr) {
+            executeWindow(*next, clock, inject);
+            fossilCollect(*next, clock.gvt.load());
+        }
+        advanceGvt(clock, counters);
+        if (next == nullptr) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+template <typename Inject>
+void SimulatorCore<Topology, Routing, Traffic>::executeWindow(LogicalProcess& process, TimeWarpClock& clock,
+                                                              Inject& inject) {
+    // Copying a partition costs about as much as running it for a window
+    const int kCheckpointWindows = 4;
+
+    Partition& partition = *process.partition;
+    int window = process.nextWindow;
+    if (process.checkpoints.empty() || window - process.checkpoints.back().window >= kCheckpointWindows) {
+        process.checkpoints.push_back(typename LogicalProcess::Checkpoint{window, partition});
+    }
+
+    readInputs(process, window);
+    beginWindow(partition, window);
+    int windowEnd = std::min((window + 1) * linkLatencyCycles_, clock.engine.endCycle);
+    for (int cycle = window * linkLatencyCycles_; cycle < windowEnd; ++cycle) {
+        stepPartition(partition, cycle, clock.engine, inject);
+    }
+
+    {
+        // A re-run window before the rollback target produces what is already there
+        std::lock_guard<std::mutex> guard(process.lock);
+        if (window == process.resultsBase + static_cast<int>(process.results.size())) {
+            process.results.push_back(WindowResults());
+            process.results.back().deliveries.swap(partition.results.deliveries);
+            process.results.back().totals = partition.results.totals;
+        }
+    }
+
+    sendOutputs(process, window, clock);
+    process.nextWindow = window + 1;
+    process.executedWindows++;
+    process.virtualTime.store(std::max(process.nextWindow, process.coastTarget));
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::readInputs(LogicalProcess& process, int window) {
+    {
+        std::lock_guard<std::mutex> guard(process.lock);
+        process.inputsRead = window;
+        int row = window - 1 - process.receivedBase;
+        for (size_t slot = 0; slot < process.peers.size(); ++slot) {
+            bool sent = row >= 0 && row < static_cast<int>(process.received.size());
+            process.inputs[slot] = sent ? process.received[row][slot] : nullptr;
+        }
+    }
+
+    Partition& partition = *process.partition;
+    process.viewUndo.emplace_back();
+    std::vector<std::pair<int, uint8_t>>& undo = process.viewUndo.back();
+    for (size_t slot = 0; slot < process.peers.size(); ++slot) {
+        const TimeWarpMessage* message = process.inputs[slot].get();
+        partition.inboxes[process.peers[slot]] = message != nullptr ? &message->mailbox : &process.noMessages;
+        if (message == nullptr) {
+            continue;
+        }
+        for (const std::pair<int, uint8_t>& update : message->occupancy) {
+            undo.push_back(std::make_pair(update.first, process.view[update.first]));
+            process.view[update.first] = update.second;
+        }
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::sendOutputs(LogicalProcess& process, int window,
+                                                            TimeWarpClock& clock) {
+    using MessagePtr = typename LogicalProcess::MessagePtr;
+    Partition& partition = *process.partition;
+
+    for (std::vector<std::pair<int, uint8_t>>& updates : process.updates) {
+        updates.clear();
+    }
+    for (int local : partition.changedNodes) {
+        uint8_t value = publishedOccupancy(partition, local);
+        for (uint16_t slot : process.readers[local]) {
+            process.updates[slot].push_back(std::make_pair(partition.begin + local, value));
+        }
+        partition.changed[local] = 0;
+    }
+    partition.changedNodes.clear();
+
+    while (process.sentBase + static_cast<int>(process.sent.size()) <= window) {
+        process.sent.emplace_back(process.peers.size());
+    }
+    std::vector<MessagePtr>& sent = process.sent[window - process.sentBase];
+
+    for (size_t slot = 0; slot < process.peers.size(); ++slot) {
+        Mailbox& outbox = partition.outboxes[window & 1][process.peers[slot]];
+        MessagePtr message;
+        if (!outbox.requests.empty() || !outbox.grants.empty() || !process.updates[slot].empty()) {
+            std::shared_ptr<TimeWarpMessage> built(new TimeWarpMessage());
+            built->mailbox.requests.swap(outbox.requests);
+            built->mailbox.grants.swap(outbox.grants);
+            built->occupancy.swap(process.updates[slot]);
+            message = built;
+        }
+        if (TimeWarpMessage::same(sent[slot].get(), message.get())) {
+            continue;
+        }
+        sent[slot] = message;
+
+        // A peer that already read this window's messages must roll back to read
+        // them again, and one re-running windows up to its last rollback can no
+        // longer vouch for the ones that read them
+        LogicalProcess& peer = *logicalProcesses_[process.peers[slot]];
+        std::lock_guard<std::mutex> guard(peer.lock);
+        while (peer.receivedBase + static_cast<int>(peer.received.size()) <= window) {
+            peer.received.emplace_back(peer.peers.size());
+        }
+        peer.received[window - peer.receivedBase][process.slotAtPeer[slot]] = message;
+        bool stale = peer.inputsRead > window || window + 1 < peer.coastTarget;
+        if (stale && window + 1 < peer.pendingRollback.load()) {
+            peer.pendingRollback.store(window + 1);
+            clock.rollbackEpoch.fetch_add(1);
+        }
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::rollback(LogicalProcess& process) {
+    if (process.pendingRollback.load() == INT_MAX) {
+        return;
+    }
+
+    // Held throughout, so the virtual time drops before the pending rollback clears
+    std::lock_guard<std::mutex> guard(process.lock);
+    int target = process.pendingRollback.load();
+    if (target < process.nextWindow) {
+        while (process.checkpoints.back().window > target) {
+            process.checkpoints.pop_back();
+        }
+        int restart = process.checkpoints.back().window;
+        *process.partition = process.checkpoints.back().state;
+
+        for (int window = process.nextWindow - 1; window >= restart; --window) {
+            const std::vector<std::pair<int, uint8_t>>& undo = process.viewUndo.back();
+            for (auto change = undo.rbegin(); change != undo.rend(); ++change) {
+                process.view[change->first] = change->second;
+            }
+            process.viewUndo.pop_back();
+        }
+
+        process.inputsRead = restart - 1;
+        process.rolledBackWindows += process.nextWindow - restart;
+        process.rollbacks++;
+        process.nextWindow = restart;
+        process.coastTarget = target;
+    } else {
+        process.coastTarget = std::min(process.coastTarget, target);
+    }
+    while (process.resultsBase + static_cast<int>(process.results.size()) > target) {
+        process.results.pop_back();
+    }
+    process.virtualTime.store(std::max(process.nextWindow, process.coastTarget));
+    process.pendingRollback.store(INT_MAX);
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::fossilCollect(LogicalProcess& process, int gvt) {
+    // Keep the latest checkpoint at or before GVT and everything needed to run on from it
+    while (process.checkpoints.size() > 1 && process.checkpoints[1].window <= gvt) {
+        process.checkpoints.pop_front();
+    }
+    int keep = process.checkpoints.front().window;
+
+    while (process.viewUndoBase < keep && !process.viewUndo.empty()) {
+        process.viewUndo.pop_front();
+        process.viewUndoBase++;
+    }
+    while (process.sentBase < keep && !process.sent.empty()) {
+        process.sent.pop_front();
+        process.sentBase++;
+    }
+
+    std::lock_guard<std::mutex> guard(process.lock);
+    while (process.receivedBase < keep - 1 && !process.received.empty()) {
+        process.received.pop_front();
+        process.receivedBase++;
+    }
+}
+
+template <typename Topology, typename Routing, typename Traffic>
+void SimulatorCore<Topology, Routing, Traffic>::advanceGvt(TimeWarpClock& clock, MeasurementCounters& counters) {
+    // Rollbacks only reach past a window their sender is still at, so the
+    // minimum read here stays valid unless one was flagged during the scan
+    long long epoch = clock.rollbackEpoch.load();
+    int gvt = clock.windowCount;
+    for (auto& process : logicalProcesses_) {
+        gvt = std::min(gvt, process->pendingRollback.load());
+        gvt = std::min(gvt, process->virtualTime.load());
+    }
+    if (clock.rollbackEpoch.load() != epoch) {
+        return;
+    }
+    int previous = clock.gvt.load();
+    while (gvt > previous && !clock.gvt.compare_exchange_weak(previous, gvt)) {
+    }
+
+    std::unique_lock<std::mutex> commit(clock.commitLock, std::try_to_lock);
+    if (!commit.owns_lock()) {
+        return;
+    }
+
+    // Windows before GVT are final: record them in order
+    EngineClock& engine = clock.engine;
+    while (!engine.finished && engine.windowStart / linkLatencyCycles_ < clock.gvt.load()) {
+        for (auto& process : logicalProcesses_) {
+            std::lock_guard<std::mutex> guard(process->lock);
+            windowResults_[process->partition->index] = &process->results.front();
+        }
+        recordWindow(engine, counters);
+        for (auto& process : logicalProcesses_) {
+            std::lock_guard<std::mutex> guard(process->lock);
+            process->results.pop_front();
+            process->resultsBase++;
+        }
+    }
+    if (engine.finished) {
+        clock.finished.store(true);
+    }
+}
+
+#endif // SIMULATOR_CORE_TIME_WARP_H
@@ -0,0 +1,39 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef SIMULATOR_ENGINE_H
+#define SIMULATOR_ENGINE_H
+
+class Config;
+class Metrics;
+
+/**
+ * @brief Type-erased interface to a compiled simulation engine
+ *
+ * Only whole runs cross this interface; everything inside a run is
+ * resolved at compile time by the concrete SimulatorCore instantiation.
+ */
+class SimulatorEngine {
+public:
+    virtual ~SimulatorEngine() = default;
+
+    /**
+     * @brief Run warmup and measurement at one injection rate
+     */
+    virtual void runSimulation(double injectionRate, const Config& config) = 0;
+
+    /**
+     * @brief Seed the random streams used by subsequent runs
+     */
+    virtual void setSeed(unsigned seed) = 0;
+
+    virtual void reset() = 0;
+    virtual Metrics* getMetrics() = 0;
+};
+
+#endif // SIMULATOR_ENGINE_H
@@ -0,0 +1,81 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Calendar queue of entries waiting out a link delay
+ *
+ * Slot i holds the entries due at every cycle congruent to i modulo the
+ * wheel size. The wheel has more slots than the longest delay it must
+ * hold, so each slot only ever contains entries due in one cycle:
+ * schedule() appends in O(1), and a cycle's entries are read and released
+ * without scanning any other slot. Entries of a slot stay in schedule order.
+ */
+template <typename T>
+class TimingWheel {
+public:
+    TimingWheel() : slots_(1), mask_(0), size_(0) {}
+
+    /**
+     * @brief Empty the wheel and size it for delays of up to horizon cycles
+     */
+    void initialize(int horizon) {
+        int slotCount = 1;
+        while (slotCount <= horizon) {
+            slotCount <<= 1;
+        }
+        if (static_cast<int>(slots_.size()) != slotCount) {
+            slots_.assign(slotCount, std::vector<T>());
+        } else {
+            clear();
+        }
+        mask_ = slotCount - 1;
+        size_ = 0;
+    }
+
+    /**
+     * @brief Add an entry due at cycle, at most horizon cycles after the current one
+     */
+    void schedule(int cycle, const T& entry) {
+        slots_[cycle & mask_].push_back(entry);
+        size_++;
+    }
+
+    /**
+     * @brief Entries due at cycle, in schedule order; release(cycle) once handled
+     */
+    const std::vector<T>& due(int cycle) const { return slots_[cycle & mask_]; }
+
+    void release(int cycle) {
+        std::vector<T>& slot = slots_[cycle & mask_];
+        size_ -= slot.size();
+        slot.clear();
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void clear() {
+        for (std::vector<T>& slot : slots_) {
+            slot.clear();
+        }
+        size_ = 0;
+    }
+
+private:
+    std::vector<std::vector<T>> slots_;
+    int mask_;
+    size_t size_;
+};
+
+#endif // TIMING_WHEEL_H
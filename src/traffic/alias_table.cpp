@@ -0,0 +1,60 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "traffic/alias_table.h"
+#include <cmath>
+#include <stdexcept>
+
+AliasTable::AliasTable(const std::vector<double>& weights) {
+    double total = 0.0;
+    for (double weight : weights) {
+        if (!(weight >= 0.0) || std::isinf(weight)) {
+            throw std::invalid_argument("Alias table weights must be finite and non-negative");
+        }
+        total += weight;
+    }
+    if (!(total > 0.0)) {
+        throw std::invalid_argument("Alias table needs a positive weight");
+    }
+
+    // Scale so the mean column holds exactly 1, then pair each short
+    // column with a tall one that tops it up
+    int n = static_cast<int>(weights.size());
+    std::vector<double> scaled(n);
+    std::vector<int> small;
+    std::vector<int> large;
+    for (int i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    columns_.resize(n);
+    while (!small.empty() && !large.empty()) {
+        int shortColumn = small.back();
+        int tallColumn = large.back();
+        small.pop_back();
+        columns_[shortColumn].threshold = static_cast<uint32_t>(scaled[shortColumn] * 4294967296.0);
+        columns_[shortColumn].alias = tallColumn;
+
+        scaled[tallColumn] -= 1.0 - scaled[shortColumn];
+        if (scaled[tallColumn] < 1.0) {
+            large.pop_back();
+            small.push_back(tallColumn);
+        }
+    }
+
+    // Whatever is left is full up to rounding
+    for (int i : large) {
+        columns_[i].threshold = UINT32_MAX;
+        columns_[i].alias = i;
+    }
+    for (int i : small) {
+        columns_[i].threshold = UINT32_MAX;
+        columns_[i].alias = i;
+    }
+}
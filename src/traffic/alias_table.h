@@ -0,0 +1,52 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include "utils/philox_random.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Walker's alias method: O(1) draws from a fixed discrete distribution
+ *
+ * Built with Vose's O(n) construction. Column i keeps itself with
+ * probability threshold / 2^32 and otherwise yields its alias, so a
+ * draw is one multiply-shift, one load and one compare.
+ */
+class AliasTable {
+public:
+    AliasTable() = default;
+
+    /**
+     * @throws std::invalid_argument if a weight is negative or not finite, or all are zero
+     */
+    explicit AliasTable(const std::vector<double>& weights);
+
+    int size() const { return static_cast<int>(columns_.size()); }
+
+    /**
+     * @brief Index drawn with probability proportional to its weight
+     */
+    int sample(uint32_t columnWord, uint32_t coinWord) const {
+        uint32_t index = Philox4x32::toRange(columnWord, static_cast<uint32_t>(columns_.size()));
+        const Column& column = columns_[index];
+        return coinWord < column.threshold ? static_cast<int>(index) : column.alias;
+    }
+
+private:
+    struct Column {
+        uint32_t threshold;
+        int32_t alias;
+    };
+
+    std::vector<Column> columns_;
+};
+
+#endif // ALIAS_TABLE_H
@@ -1,27 +1,47 @@
 #include "hotspot_traffic.h"
-#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 
-HotspotTraffic::HotspotTraffic(int networkSize) : TrafficPattern(networkSize) {}
+HotspotTraffic::HotspotTraffic(int networkSize, const std::vector<int>& hotspotNodes, double hotspotRatio)
+    : MatrixTraffic(networkSize) {
+    if (!(hotspotRatio >= 0.0 && hotspotRatio <= 1.0)) {
+        throw std::invalid_argument("hotspot_ratio must be between 0 and 1");
+    }
+    if (networkSize < 2) {
+        return;
+    }
 
-void HotspotTraffic::generateTraffic() {
-}
+    std::vector<int> hotspots = hotspotNodes.empty() ? std::vector<int>(1, networkSize - 1) : hotspotNodes;
+    std::sort(hotspots.begin(), hotspots.end());
+    hotspots.erase(std::unique(hotspots.begin(), hotspots.end()), hotspots.end());
+    if (hotspots.front() < 0 || hotspots.back() >= networkSize) {
+        throw std::invalid_argument("Hotspot node out of range for a network of " + std::to_string(networkSize) +
+                                    " nodes");
+    }
 
-std::vector<int> HotspotTraffic::generateTrafficVector() {
-    std::vector<int> traffic(networkSize_);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    
-    int hotspotNode = networkSize_ - 1;
-    
-    for (int i = 0; i < networkSize_; ++i) {
-        if (dis(gen) < 0.3) {
-            traffic[i] = hotspotNode;
-        } else {
-            std::uniform_int_distribution<> nodeDis(0, networkSize_ - 1);
-            traffic[i] = nodeDis(gen);
+    // Distribution over the given hotspots plus a uniform background
+    auto addHotspotClass = [this, hotspotRatio](const std::vector<int>& targets) {
+        std::vector<int> destinations(targets);
+        std::vector<double> weights(targets.size(), targets.empty() ? 0.0 : hotspotRatio / targets.size());
+        destinations.push_back(kAnyOtherNode);
+        weights.push_back(targets.empty() ? 1.0 : 1.0 - hotspotRatio);
+        return addClass(destinations, weights);
+    };
+
+    int ordinaryClass = addHotspotClass(hotspots);
+    for (int source = 0; source < networkSize; ++source) {
+        if (!std::binary_search(hotspots.begin(), hotspots.end(), source)) {
+            assignClass(source, ordinaryClass);
+        }
+    }
+    for (int hotspot : hotspots) {
+        std::vector<int> others;
+        for (int other : hotspots) {
+            if (other != hotspot) {
+                others.push_back(other);
+            }
         }
+        assignClass(hotspot, addHotspotClass(others));
     }
-    
-    return traffic;
-}
\ No newline at end of file
+}
@@ -1,13 +1,27 @@
 #ifndef HOTSPOT_TRAFFIC_H
 #define HOTSPOT_TRAFFIC_H
 
-#include "traffic_pattern.h"
+#include "traffic/matrix_traffic.h"
+#include <vector>
 
-class HotspotTraffic : public TrafficPattern {
+/**
+ * @brief Uniform traffic with a share of every source's packets sent to hotspot nodes
+ *
+ * Each source sends hotspotRatio of its packets to the hotspots, spread
+ * evenly, and the rest uniformly to any other node. A hotspot spreads its
+ * own share over the other hotspots, so with a single hotspot that node
+ * sends uniformly. Built as a traffic matrix with one class for ordinary
+ * sources and one per hotspot.
+ */
+class HotspotTraffic : public MatrixTraffic {
 public:
-    HotspotTraffic(int networkSize);
-    void generateTraffic() override;
-    std::vector<int> generateTrafficVector() override;
+    /**
+     * @param hotspotNodes Hotspot node ids; empty selects the last node
+     * @throws std::invalid_argument if a node is out of range or the ratio is outside [0, 1]
+     */
+    HotspotTraffic(int networkSize, const std::vector<int>& hotspotNodes, double hotspotRatio = 0.3);
+
+    std::string getName() const override { return "hotspot"; }
 };
 
-#endif // HOTSPOT_TRAFFIC_H
\ No newline at end of file
+#endif // HOTSPOT_TRAFFIC_H
@@ -0,0 +1,227 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "traffic/injection_trace.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[8] = {'O', 'M', 'N', 'I', 'T', 'R', 'C', '\0'};
+
+size_t pageSize() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// Sweep points are told apart by rate and seed, as in the results file
+std::string pointFileName(double injectionRate, unsigned seed) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "rate-%.6f-seed-%u.trace", injectionRate, seed);
+    return name;
+}
+
+} // namespace
+
+void InjectionTraceFormat::fillMagic(char* magic) {
+    std::memcpy(magic, kMagic, sizeof(kMagic));
+}
+
+bool InjectionTraceFormat::hasMagic(const char* magic) {
+    return std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::string InjectionTraceFormat::capturePath(const std::string& directory, double injectionRate, unsigned seed) {
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Cannot create trace directory: " + directory);
+    }
+    return directory + "/" + pointFileName(injectionRate, seed);
+}
+
+std::string InjectionTraceFormat::replayPath(const std::string& path, double injectionRate, unsigned seed) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+        return path + "/" + pointFileName(injectionRate, seed);
+    }
+    return path;
+}
+
+InjectionTraceWriter::InjectionTraceWriter(const std::string& path, int nodeCount)
+    : path_(path), temporaryPath_(path + ".tmp." + std::to_string(getpid())), buffer_(kBufferBytes), used_(0),
+      nodeCount_(nodeCount), lastCycle_(0), recordCount_(0), payloadBytes_(0), closed_(false) {
+    out_.open(temporaryPath_, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        throw std::runtime_error("Cannot create injection trace: " + temporaryPath_);
+    }
+
+    // Placeholder until close() knows the counts
+    InjectionTraceFormat::Header header;
+    std::memset(&header, 0, sizeof(header));
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+InjectionTraceWriter::~InjectionTraceWriter() {
+    if (!closed_) {
+        out_.close();
+        std::remove(temporaryPath_.c_str());
+    }
+}
+
+void InjectionTraceWriter::flush() {
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(used_));
+    payloadBytes_ += used_;
+    used_ = 0;
+}
+
+void InjectionTraceWriter::throwOutOfOrder(int64_t cycle) const {
+    throw std::invalid_argument("Injection trace records must be in cycle order: " + std::to_string(cycle) +
+                                " after " + std::to_string(lastCycle_));
+}
+
+void InjectionTraceWriter::close() {
+    flush();
+
+    InjectionTraceFormat::Header header;
+    std::memset(&header, 0, sizeof(header));
+    InjectionTraceFormat::fillMagic(header.magic);
+    header.version = InjectionTraceFormat::kVersion;
+    header.byteOrder = InjectionTraceFormat::kByteOrderMark;
+    header.nodeCount = nodeCount_;
+    header.recordCount = recordCount_;
+    header.payloadBytes = payloadBytes_;
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    closed_ = true;
+
+    if (!out_ || std::rename(temporaryPath_.c_str(), path_.c_str()) != 0) {
+        std::remove(temporaryPath_.c_str());
+        throw std::runtime_error("Cannot write injection trace: " + path_);
+    }
+}
+
+InjectionTraceReader::InjectionTraceReader(const std::string& path)
+    : path_(path), mapping_(nullptr), mappingBytes_(0), cursor_(nullptr), end_(nullptr), prefetchedTo_(0),
+      releasedTo_(0), nodeCount_(0), recordCount_(0), decodedCount_(0), hasPending_(false) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open injection trace: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(InjectionTraceFormat::Header)) {
+        close(fd);
+        throw std::runtime_error("Not an injection trace: " + path);
+    }
+    mappingBytes_ = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, mappingBytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map injection trace: " + path);
+    }
+    mapping_ = static_cast<const uint8_t*>(address);
+    madvise(address, mappingBytes_, MADV_SEQUENTIAL);
+
+    InjectionTraceFormat::Header header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (!InjectionTraceFormat::hasMagic(header.magic) || header.version != InjectionTraceFormat::kVersion ||
+        header.byteOrder != InjectionTraceFormat::kByteOrderMark ||
+        header.payloadBytes != mappingBytes_ - sizeof(header)) {
+        munmap(address, mappingBytes_);
+        throw std::runtime_error("Not an injection trace or truncated: " + path);
+    }
+    nodeCount_ = header.nodeCount;
+    recordCount_ = header.recordCount;
+
+    cursor_ = mapping_ + sizeof(header);
+    end_ = mapping_ + mappingBytes_;
+    pending_.cycle = 0;
+    slideWindow();
+    advance();
+}
+
+InjectionTraceReader::~InjectionTraceReader() {
+    if (mapping_) {
+        munmap(const_cast<uint8_t*>(mapping_), mappingBytes_);
+    }
+}
+
+uint64_t InjectionTraceReader::getVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor_ == end_) {
+            throw std::runtime_error("Truncated injection trace record: " + path_);
+        }
+        uint8_t byte = *cursor_++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed injection trace record: " + path_);
+}
+
+int InjectionTraceReader::getInt() {
+    uint64_t value = getVarint();
+    if (value > static_cast<uint64_t>(INT32_MAX)) {
+        throw std::runtime_error("Malformed injection trace record: " + path_);
+    }
+    return static_cast<int>(value);
+}
+
+void InjectionTraceReader::advance() {
+    if (cursor_ == end_) {
+        // A payload cut at a record boundary still decodes; only the count tells
+        if (decodedCount_ != recordCount_) {
+            throw std::runtime_error("Truncated injection trace: " + path_ + " holds " +
+                                     std::to_string(decodedCount_) + " of " + std::to_string(recordCount_) +
+                                     " records");
+        }
+        hasPending_ = false;
+        return;
+    }
+    pending_.cycle += static_cast<int64_t>(getVarint());
+    pending_.source = getInt();
+    pending_.destination = getInt();
+    pending_.size = getInt();
+    decodedCount_++;
+    hasPending_ = true;
+
+    // Move the window on once the cursor is half way through it
+    size_t offset = static_cast<size_t>(cursor_ - mapping_);
+    if (prefetchedTo_ < mappingBytes_ && offset + kPrefetchBytes / 2 > prefetchedTo_) {
+        slideWindow();
+    }
+}
+
+void InjectionTraceReader::slideWindow() {
+    size_t page = pageSize();
+    size_t offset = static_cast<size_t>(cursor_ - mapping_);
+    uint8_t* base = const_cast<uint8_t*>(mapping_);
+
+    // Read the next window ahead of the cursor
+    size_t start = offset / page * page;
+    size_t length = mappingBytes_ - start;
+    if (length > kPrefetchBytes) {
+        length = kPrefetchBytes;
+    }
+    madvise(base + start, length, MADV_WILLNEED);
+    prefetchedTo_ = start + length;
+
+    // Drop the pages already decoded; they are clean and never read again
+    if (start - releasedTo_ >= kPrefetchBytes) {
+        madvise(base + releasedTo_, start - releasedTo_, MADV_DONTNEED);
+        releasedTo_ = start;
+    }
+}
@@ -0,0 +1,192 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef INJECTION_TRACE_H
+#define INJECTION_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One injected packet of a trace
+ */
+struct InjectionTraceRecord {
+    int64_t cycle;
+    int source;
+    int destination;
+    int size;  // Flits
+};
+
+/**
+ * @brief Binary injection trace file layout
+ *
+ * A fixed header followed by records in nondecreasing cycle order. Each
+ * record is four LEB128 varints: the cycle minus the previous record's
+ * cycle, source, destination and size, so a packet costs four to eight
+ * bytes depending on how wide the node ids are.
+ */
+struct InjectionTraceFormat {
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        int32_t nodeCount;
+        uint32_t reserved;
+        uint64_t recordCount;
+        uint64_t payloadBytes;
+    };
+
+    static const uint32_t kVersion = 1;
+    static const uint32_t kByteOrderMark = 0x01020304u;
+
+    static void fillMagic(char* magic);
+    static bool hasMagic(const char* magic);
+
+    /**
+     * @brief File a sweep point is captured to inside directory, which is created if needed
+     * @throws std::runtime_error if the directory cannot be created
+     */
+    static std::string capturePath(const std::string& directory, double injectionRate, unsigned seed);
+
+    /**
+     * @brief Trace a sweep point replays: path itself, or the point's file if path is a capture directory
+     */
+    static std::string replayPath(const std::string& path, double injectionRate, unsigned seed);
+};
+
+/**
+ * @brief Streams records to a trace file through a fixed-size buffer
+ *
+ * Records go to a private temporary file that close() renames into
+ * place, so a reader never sees a partial trace.
+ */
+class InjectionTraceWriter {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be created
+     */
+    InjectionTraceWriter(const std::string& path, int nodeCount);
+
+    // Discards the trace unless close() was called
+    ~InjectionTraceWriter();
+
+    /**
+     * @throws std::invalid_argument if cycle is earlier than the previous record's
+     */
+    void append(int64_t cycle, int source, int destination, int size) {
+        if (cycle < lastCycle_) {
+            throwOutOfOrder(cycle);
+        }
+        if (buffer_.size() - used_ < kMaxRecordBytes) {
+            flush();
+        }
+        putVarint(static_cast<uint64_t>(cycle - lastCycle_));
+        putVarint(static_cast<uint32_t>(source));
+        putVarint(static_cast<uint32_t>(destination));
+        putVarint(static_cast<uint32_t>(size));
+        lastCycle_ = cycle;
+        recordCount_++;
+    }
+
+    /**
+     * @brief Finish the header and publish the file
+     * @throws std::runtime_error if writing or renaming fails
+     */
+    void close();
+
+    uint64_t getRecordCount() const { return recordCount_; }
+
+private:
+    static const size_t kBufferBytes = size_t(1) << 20;
+    static const size_t kMaxRecordBytes = 10 + 3 * 5;
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer_[used_++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        buffer_[used_++] = static_cast<uint8_t>(value);
+    }
+
+    void flush();
+    void throwOutOfOrder(int64_t cycle) const;
+
+    std::string path_;
+    std::string temporaryPath_;
+    std::ofstream out_;
+    std::vector<uint8_t> buffer_;
+    size_t used_;
+    int nodeCount_;
+    int64_t lastCycle_;
+    uint64_t recordCount_;
+    uint64_t payloadBytes_;
+    bool closed_;
+};
+
+/**
+ * @brief Replays a trace file mapped read-only with mmap
+ *
+ * Records are decoded in place as the simulation reaches their cycle.
+ * The reader asks the kernel to read the next few MiB ahead of the cursor
+ * and drops the pages it has passed, so resident memory stays bounded by
+ * that window however long the trace is.
+ */
+class InjectionTraceReader {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped or is not a trace
+     */
+    explicit InjectionTraceReader(const std::string& path);
+    ~InjectionTraceReader();
+
+    /**
+     * @brief Take the next record injected at or before cycle, if any
+     * @throws std::runtime_error if the record is truncated or a field does not fit an int,
+     *         or the trace ends short of the header's record count
+     */
+    bool next(int64_t cycle, InjectionTraceRecord& record) {
+        if (!hasPending_ || pending_.cycle > cycle) {
+            return false;
+        }
+        record = pending_;
+        advance();
+        return true;
+    }
+
+    int getNodeCount() const { return nodeCount_; }
+    uint64_t getRecordCount() const { return recordCount_; }
+
+private:
+    static const size_t kPrefetchBytes = size_t(4) << 20;
+
+    InjectionTraceReader(const InjectionTraceReader&) = delete;
+    InjectionTraceReader& operator=(const InjectionTraceReader&) = delete;
+
+    void advance();
+    uint64_t getVarint();
+    int getInt();
+    void slideWindow();
+
+    std::string path_;
+    const uint8_t* mapping_;
+    size_t mappingBytes_;
+    const uint8_t* cursor_;
+    const uint8_t* end_;
+    size_t prefetchedTo_;  // Offsets into the mapping
+    size_t releasedTo_;
+    int nodeCount_;
+    uint64_t recordCount_;
+    uint64_t decodedCount_;
+    InjectionTraceRecord pending_;
+    bool hasPending_;
+};
+
+#endif // INJECTION_TRACE_H
@@ -0,0 +1,200 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "traffic/matrix_traffic.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Numbers of a whole matrix file, with '#' comments skipped
+class NumberReader {
+public:
+    NumberReader(const std::string& path, const std::string& text)
+        : path_(path), position_(text.c_str()), end_(text.c_str() + text.size()), line_(1) {}
+
+    bool next(double& value) {
+        skipBlanks();
+        if (position_ == end_) {
+            return false;
+        }
+        char* parsed = nullptr;
+        value = std::strtod(position_, &parsed);
+        if (parsed == position_) {
+            fail("expected a number");
+        }
+        position_ = parsed;
+        return true;
+    }
+
+    int nextNode(int networkSize, int entryLine) {
+        double value;
+        if (!next(value)) {
+            fail("incomplete entry", entryLine);
+        }
+        if (value != std::floor(value) || value < 0 || value >= networkSize) {
+            fail("node id out of range");
+        }
+        return static_cast<int>(value);
+    }
+
+    void checkWeight(double weight) const {
+        if (!(weight >= 0.0) || std::isinf(weight)) {
+            fail("weight must be finite and non-negative");
+        }
+    }
+
+    int line() const { return line_; }
+
+    [[noreturn]] void fail(const std::string& reason) const {
+        fail(reason, line_);
+    }
+
+    [[noreturn]] void fail(const std::string& reason, int line) const {
+        throw std::invalid_argument(path_ + ":" + std::to_string(line) + ": " + reason);
+    }
+
+private:
+    void skipBlanks() {
+        while (position_ != end_) {
+            char c = *position_;
+            if (c == '#') {
+                while (position_ != end_ && *position_ != '\n') {
+                    ++position_;
+                }
+            } else if (c == '\n') {
+                ++line_;
+                ++position_;
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == ',') {
+                ++position_;
+            } else {
+                break;
+            }
+        }
+    }
+
+    const std::string& path_;
+    const char* position_;
+    const char* end_;
+    int line_;
+};
+
+} // namespace
+
+const int MatrixTraffic::kAnyOtherNode;
+
+MatrixTraffic::MatrixTraffic(int networkSize) : TrafficPattern(networkSize), classOf_(networkSize, -1) {}
+
+std::unique_ptr<MatrixTraffic> MatrixTraffic::load(const std::string& path, const std::string& format,
+                                                   int networkSize) {
+    if (format != "sparse" && format != "dense") {
+        throw std::invalid_argument("Unknown traffic matrix format: " + format);
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open traffic matrix: " + path);
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    std::string text = contents.str();
+    NumberReader reader(path, text);
+
+    std::vector<std::vector<int>> destinations(networkSize);
+    std::vector<std::vector<double>> weights(networkSize);
+    double weight;
+    if (format == "dense") {
+        for (int source = 0; source < networkSize; ++source) {
+            for (int destination = 0; destination < networkSize; ++destination) {
+                if (!reader.next(weight)) {
+                    reader.fail("expected " + std::to_string(networkSize) + " rows of " +
+                                std::to_string(networkSize) + " weights");
+                }
+                reader.checkWeight(weight);
+                if (weight != 0.0 && destination != source) {
+                    destinations[source].push_back(destination);
+                    weights[source].push_back(weight);
+                }
+            }
+        }
+        if (reader.next(weight)) {
+            reader.fail("more weights than the network has nodes");
+        }
+    } else {
+        double first;
+        while (reader.next(first)) {
+            // An entry cut short is reported where it starts, not where the file ends
+            int entryLine = reader.line();
+            if (first != std::floor(first) || first < 0 || first >= networkSize) {
+                reader.fail("node id out of range");
+            }
+            int source = static_cast<int>(first);
+            int destination = reader.nextNode(networkSize, entryLine);
+            if (!reader.next(weight)) {
+                reader.fail("incomplete entry", entryLine);
+            }
+            reader.checkWeight(weight);
+            if (weight != 0.0 && destination != source) {
+                destinations[source].push_back(destination);
+                weights[source].push_back(weight);
+            }
+        }
+    }
+
+    std::unique_ptr<MatrixTraffic> matrix(new MatrixTraffic(networkSize));
+    for (int source = 0; source < networkSize; ++source) {
+        if (!destinations[source].empty()) {
+            matrix->assignClass(source, matrix->addClass(destinations[source], weights[source]));
+        }
+        // Release rows as they are tabulated so peak memory stays near one copy
+        std::vector<int>().swap(destinations[source]);
+        std::vector<double>().swap(weights[source]);
+    }
+    return matrix;
+}
+
+int MatrixTraffic::addClass(const std::vector<int>& destinations, const std::vector<double>& weights) {
+    SourceClass sourceClass;
+    sourceClass.table = AliasTable(weights);
+    sourceClass.destinations = destinations;
+    classes_.push_back(std::move(sourceClass));
+    return static_cast<int>(classes_.size()) - 1;
+}
+
+void MatrixTraffic::assignClass(int source, int sourceClass) {
+    for (int destination : classes_[sourceClass].destinations) {
+        if (destination == source) {
+            throw std::invalid_argument("Traffic class sends node " + std::to_string(source) + " to itself");
+        }
+    }
+    classOf_[source] = sourceClass;
+}
+
+void MatrixTraffic::fillDestinations(const int* sources, int count, int cycle, const Philox4x32& stream,
+                                     int* destinations) const {
+    for (int i = 0; i < count; ++i) {
+        int source = sources[i];
+        int sourceClass = classOf_[source];
+        if (sourceClass < 0) {
+            destinations[i] = -1;
+            continue;
+        }
+
+        const SourceClass& entry = classes_[sourceClass];
+        Philox4x32::Block block = stream(static_cast<uint32_t>(source), static_cast<uint32_t>(cycle),
+                                         kDestinationStream, 0);
+        int destination = entry.destinations[entry.table.sample(block.v[0], block.v[1])];
+        if (destination == kAnyOtherNode) {
+            destination = static_cast<int>(Philox4x32::toRange(block.v[2], networkSize_ - 1));
+            destination += destination >= source ? 1 : 0;
+        }
+        destinations[i] = destination;
+    }
+}
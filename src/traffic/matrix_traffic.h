@@ -0,0 +1,76 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef MATRIX_TRAFFIC_H
+#define MATRIX_TRAFFIC_H
+
+#include "traffic/alias_table.h"
+#include "traffic/traffic_pattern.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Destinations drawn from a per-source weight distribution
+ *
+ * Each source belongs to a class: a set of weighted destinations with an
+ * alias table over them, so a draw costs one random block whatever the
+ * shape of the distribution. Sources with the same distribution share
+ * one class (every non-hotspot node of a hotspot pattern, say), which
+ * keeps symmetric patterns O(destinations) in memory instead of O(N^2).
+ * A destination of kAnyOtherNode stands for "uniformly any node but the
+ * source", letting a class mix a uniform background into a few heavy
+ * destinations. Sources without a class send nothing.
+ */
+class MatrixTraffic : public TrafficPattern {
+public:
+    static const int kAnyOtherNode = -2;
+
+    explicit MatrixTraffic(int networkSize);
+
+    /**
+     * @brief Read an N x N weight matrix; row = source, column = destination
+     * @param format "sparse": one "source destination weight" line per entry, or
+     *               "dense": N rows of N weights. '#' starts a comment in either.
+     * @throws std::runtime_error if the file cannot be read
+     * @throws std::invalid_argument prefixed with "path:line: " if it is malformed or does not fit the network
+     *
+     * The diagonal is ignored; sources whose row is all zero stay silent.
+     */
+    static std::unique_ptr<MatrixTraffic> load(const std::string& path, const std::string& format,
+                                               int networkSize);
+
+    /**
+     * @brief Add a distribution any number of sources can share
+     * @return Class id for assignClass()
+     * @throws std::invalid_argument if a weight is negative or all are zero
+     */
+    int addClass(const std::vector<int>& destinations, const std::vector<double>& weights);
+
+    /**
+     * @throws std::invalid_argument if the class can send a packet back to source
+     */
+    void assignClass(int source, int sourceClass);
+
+    void fillDestinations(const int* sources, int count, int cycle, const Philox4x32& stream,
+                          int* destinations) const override;
+    std::string getName() const override { return "matrix"; }
+
+    int getClassCount() const { return static_cast<int>(classes_.size()); }
+
+private:
+    struct SourceClass {
+        AliasTable table;
+        std::vector<int> destinations;
+    };
+
+    std::vector<SourceClass> classes_;
+    std::vector<int> classOf_;
+};
+
+#endif // MATRIX_TRAFFIC_H
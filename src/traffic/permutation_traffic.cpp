@@ -0,0 +1,116 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "traffic/permutation_traffic.h"
+#include "traffic/permutations.h"
+#include <stdexcept>
+
+namespace {
+
+int nodeCountOf(const std::vector<int>& radices) {
+    int nodes = 1;
+    for (int radix : radices) {
+        nodes *= radix;
+    }
+    return nodes;
+}
+
+// Address bits of a power-of-two node count, or -1 otherwise
+int addressBits(int nodes) {
+    if (nodes <= 0 || (nodes & (nodes - 1)) != 0) {
+        return -1;
+    }
+    return __builtin_ctz(static_cast<unsigned>(nodes));
+}
+
+} // namespace
+
+PermutationTraffic::PermutationTraffic(Kind kind, const std::vector<int>& radices)
+    : TrafficPattern(nodeCountOf(radices)), kind_(kind) {
+    int bits = addressBits(networkSize_);
+    switch (kind) {
+    case Kind::BIT_COMPLEMENT:
+    case Kind::BIT_REVERSE:
+    case Kind::SHUFFLE:
+        if (bits < 0) {
+            throw std::invalid_argument(nameOf(kind) + " traffic needs a power-of-two node count");
+        }
+        break;
+    case Kind::TRANSPOSE:
+        if (radices.size() == 2 ? radices[0] != radices[1] : (radices.size() != 1 || bits < 0 || bits % 2 != 0)) {
+            throw std::invalid_argument("transpose traffic needs a square mesh or an even number of address bits");
+        }
+        break;
+    case Kind::TORNADO:
+    case Kind::NEIGHBOR:
+        break;
+    }
+
+    destinations_.resize(networkSize_);
+    for (int node = 0; node < networkSize_; ++node) {
+        int destination = permute(node, radices, bits);
+        destinations_[node] = destination == node ? -1 : destination;
+    }
+}
+
+void PermutationTraffic::fillDestinations(const int* sources, int count, int /*cycle*/, const Philox4x32& /*stream*/,
+                                          int* destinations) const {
+    for (int i = 0; i < count; ++i) {
+        destinations[i] = destinations_[sources[i]];
+    }
+}
+
+std::string PermutationTraffic::nameOf(Kind kind) {
+    switch (kind) {
+    case Kind::BIT_COMPLEMENT:
+        return "bit_complement";
+    case Kind::BIT_REVERSE:
+        return "bit_reverse";
+    case Kind::SHUFFLE:
+        return "shuffle";
+    case Kind::TRANSPOSE:
+        return "transpose";
+    case Kind::TORNADO:
+        return "tornado";
+    case Kind::NEIGHBOR:
+        return "neighbor";
+    }
+    return "permutation";
+}
+
+int PermutationTraffic::permute(int node, const std::vector<int>& radices, int bits) const {
+    switch (kind_) {
+    case Kind::BIT_COMPLEMENT:
+        return TrafficPermutations::bitComplement(node, bits);
+    case Kind::BIT_REVERSE:
+        return TrafficPermutations::bitReverse(node, bits);
+    case Kind::SHUFFLE:
+        return TrafficPermutations::shuffle(node, bits);
+    case Kind::TRANSPOSE:
+        if (radices.size() == 2) {
+            return (node % radices[0]) * radices[0] + node / radices[0];
+        }
+        return TrafficPermutations::bitTranspose(node, bits);
+    case Kind::TORNADO:
+    case Kind::NEIGHBOR: {
+        // Digit by digit, lowest dimension first
+        int destination = 0;
+        int weight = 1;
+        for (int radix : radices) {
+            int digit = node % radix;
+            node /= radix;
+            digit = kind_ == Kind::TORNADO ? TrafficPermutations::tornadoDigit(digit, radix)
+                                           : TrafficPermutations::neighborDigit(digit, radix);
+            destination += digit * weight;
+            weight *= radix;
+        }
+        return destination;
+    }
+    }
+    return node;
+}
@@ -0,0 +1,60 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef PERMUTATION_TRAFFIC_H
+#define PERMUTATION_TRAFFIC_H
+
+#include "traffic_pattern.h"
+#include <vector>
+
+/**
+ * @brief Every source always sends to the same node
+ *
+ * The permutation is evaluated once per source when the pattern is built,
+ * so a destination is a single table load. Nodes the permutation maps to
+ * themselves do not inject.
+ *
+ * The shape is the radix of each dimension, lowest first, matching node
+ * ids: {width, height} for a mesh and {nodes} for a hypercube, whose
+ * nodes tornado and neighbor traffic treat as one ring in id order. Bit
+ * permutations need a power-of-two node count; transpose swaps the
+ * coordinates of a square mesh or the address halves of a ring with an
+ * even number of address bits.
+ */
+class PermutationTraffic : public TrafficPattern {
+public:
+    enum class Kind {
+        BIT_COMPLEMENT,
+        BIT_REVERSE,
+        SHUFFLE,
+        TRANSPOSE,
+        TORNADO,
+        NEIGHBOR
+    };
+
+    /**
+     * @throws std::invalid_argument if the permutation is undefined on this shape
+     */
+    PermutationTraffic(Kind kind, const std::vector<int>& radices);
+
+    void fillDestinations(const int* sources, int count, int cycle, const Philox4x32& stream,
+                          int* destinations) const override;
+    std::string getName() const override { return nameOf(kind_); }
+
+    int destinationOf(int source) const { return destinations_[source]; }
+
+    static std::string nameOf(Kind kind);
+
+private:
+    int permute(int node, const std::vector<int>& radices, int bits) const;
+
+    Kind kind_;
+    std::vector<int> destinations_;
+};
+
+#endif // PERMUTATION_TRAFFIC_H
@@ -0,0 +1,60 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TRAFFIC_PERMUTATIONS_H
+#define TRAFFIC_PERMUTATIONS_H
+
+/**
+ * @brief Standard permutation traffic patterns on integer node ids
+ *
+ * The bit permutations treat a node id as a bits-bit address s[bits-1..0]
+ * (Dally & Towles, ch. 3). Tornado and neighbor act on one digit of a
+ * radix-k coordinate; callers apply them to every dimension.
+ */
+struct TrafficPermutations {
+    // d_i = ~s_i
+    static constexpr int bitComplement(int node, int bits) {
+        return ~node & ((1 << bits) - 1);
+    }
+
+    // d_i = s_{bits-1-i}
+    static constexpr int bitReverse(int node, int bits) {
+        int reversed = 0;
+        for (int i = 0; i < bits; ++i) {
+            reversed |= ((node >> i) & 1) << (bits - 1 - i);
+        }
+        return reversed;
+    }
+
+    // d_i = s_{(i-1) mod bits}: rotate the address left by one
+    static constexpr int shuffle(int node, int bits) {
+        return bits == 0 ? node : ((node << 1) | (node >> (bits - 1))) & ((1 << bits) - 1);
+    }
+
+    // d_i = s_{(i+bits/2) mod bits}: swap the address halves; bits must be even
+    static constexpr int bitTranspose(int node, int bits) {
+        return ((node << (bits / 2)) | (node >> (bits / 2))) & ((1 << bits) - 1);
+    }
+
+    // Almost half way round a ring of radix nodes
+    static constexpr int tornadoDigit(int digit, int radix) {
+        return (digit + (radix + 1) / 2 - 1) % radix;
+    }
+
+    static constexpr int neighborDigit(int digit, int radix) {
+        return (digit + 1) % radix;
+    }
+};
+
+static_assert(TrafficPermutations::bitComplement(0x5, 4) == 0xA, "bit complement");
+static_assert(TrafficPermutations::bitReverse(0x1, 4) == 0x8, "bit reverse");
+static_assert(TrafficPermutations::shuffle(0x9, 4) == 0x3, "shuffle");
+static_assert(TrafficPermutations::bitTranspose(0x1, 4) == 0x4, "transpose");
+static_assert(TrafficPermutations::tornadoDigit(0, 8) == 3, "tornado");
+
+#endif // TRAFFIC_PERMUTATIONS_H
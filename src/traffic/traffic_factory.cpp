@@ -0,0 +1,101 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "traffic/traffic_factory.h"
+#include "traffic/hotspot_traffic.h"
+#include "traffic/matrix_traffic.h"
+#include "traffic/permutation_traffic.h"
+#include "traffic/uniform_traffic.h"
+#include "utils/config.h"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+int nodeCountOf(const std::vector<int>& radices) {
+    int nodes = 1;
+    for (int radix : radices) {
+        nodes *= radix;
+    }
+    return nodes;
+}
+
+} // namespace
+
+TrafficFactory& TrafficFactory::getInstance() {
+    static TrafficFactory instance;
+    static std::once_flag initialized;
+
+    // Sweep workers may reach the factory concurrently
+    std::call_once(initialized, [] { instance.initializeBuiltinPatterns(); });
+
+    return instance;
+}
+
+void TrafficFactory::registerPattern(const std::string& patternName, PatternCreator creator) {
+    creators_[patternName] = creator;
+}
+
+std::unique_ptr<TrafficPattern> TrafficFactory::createPattern(const Config& config, const std::vector<int>& radices) {
+    const std::string pattern = config.getTrafficPattern();
+
+    auto it = creators_.find(pattern);
+    if (it == creators_.end()) {
+        std::string supported;
+        for (const std::string& name : getSupportedPatterns()) {
+            supported += (supported.empty() ? "" : ", ") + name;
+        }
+        throw std::invalid_argument("Unsupported traffic pattern: " + pattern + ". Supported patterns: " + supported);
+    }
+
+    return it->second(radices, config);
+}
+
+std::vector<std::string> TrafficFactory::getSupportedPatterns() const {
+    std::vector<std::string> patterns;
+    patterns.reserve(creators_.size());
+    for (const auto& pair : creators_) {
+        patterns.push_back(pair.first);
+    }
+    std::sort(patterns.begin(), patterns.end());
+    return patterns;
+}
+
+void TrafficFactory::initializeBuiltinPatterns() {
+    registerPattern("uniform", [](const std::vector<int>& radices, const Config& /*config*/) {
+        return std::unique_ptr<TrafficPattern>(new UniformTraffic(nodeCountOf(radices)));
+    });
+
+    registerPattern("hotspot", [](const std::vector<int>& radices, const Config& config) {
+        return std::unique_ptr<TrafficPattern>(
+            new HotspotTraffic(nodeCountOf(radices), config.getHotspotNodes(), config.getHotspotRatio()));
+    });
+
+    registerPattern("matrix", [](const std::vector<int>& radices, const Config& config) {
+        if (config.getTrafficMatrixFile().empty()) {
+            throw std::invalid_argument("The matrix traffic pattern needs traffic.matrix_file");
+        }
+        std::unique_ptr<TrafficPattern> pattern = MatrixTraffic::load(
+            config.getTrafficMatrixFile(), config.getTrafficMatrixFormat(), nodeCountOf(radices));
+        std::cout << "Loaded traffic matrix: " << config.getTrafficMatrixFile() << std::endl;
+        return pattern;
+    });
+
+    const PermutationTraffic::Kind permutations[] = {
+        PermutationTraffic::Kind::BIT_COMPLEMENT, PermutationTraffic::Kind::BIT_REVERSE,
+        PermutationTraffic::Kind::SHUFFLE,        PermutationTraffic::Kind::TRANSPOSE,
+        PermutationTraffic::Kind::TORNADO,        PermutationTraffic::Kind::NEIGHBOR,
+    };
+    for (PermutationTraffic::Kind kind : permutations) {
+        registerPattern(PermutationTraffic::nameOf(kind), [kind](const std::vector<int>& radices, const Config& /*config*/) {
+            return std::unique_ptr<TrafficPattern>(new PermutationTraffic(kind, radices));
+        });
+    }
+}
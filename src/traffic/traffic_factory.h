@@ -0,0 +1,60 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TRAFFIC_FACTORY_H
+#define TRAFFIC_FACTORY_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TrafficPattern;
+class Config;
+
+/**
+ * @brief Factory for the traffic pattern named by traffic.pattern
+ *
+ * Creators receive the network shape as the radix of each dimension,
+ * lowest first ({width, height} for a mesh, {nodes} for a hypercube).
+ */
+class TrafficFactory {
+public:
+    using PatternCreator = std::function<std::unique_ptr<TrafficPattern>(const std::vector<int>&, const Config&)>;
+
+    /**
+     * @brief Get the singleton instance of TrafficFactory
+     */
+    static TrafficFactory& getInstance();
+
+    /**
+     * @brief Register a traffic pattern under the name configs use for it
+     */
+    void registerPattern(const std::string& patternName, PatternCreator creator);
+
+    /**
+     * @brief Create the configured traffic pattern for a network of the given shape
+     * @throws std::invalid_argument if the pattern is unknown or undefined on the shape
+     */
+    std::unique_ptr<TrafficPattern> createPattern(const Config& config, const std::vector<int>& radices);
+
+    std::vector<std::string> getSupportedPatterns() const;
+
+private:
+    TrafficFactory() = default;
+    ~TrafficFactory() = default;
+    TrafficFactory(const TrafficFactory&) = delete;
+    TrafficFactory& operator=(const TrafficFactory&) = delete;
+
+    std::unordered_map<std::string, PatternCreator> creators_;
+
+    void initializeBuiltinPatterns();
+};
+
+#endif // TRAFFIC_FACTORY_H
@@ -1,7 +1,7 @@
 /*
  * omni_simulator - Network Routing Simulator
  * Copyright (c) 2025 nash635
- * 
+ *
  * This software is licensed under the MIT License.
  * See the LICENSE file for more details.
  */
@@ -9,25 +9,46 @@
 #ifndef TRAFFIC_PATTERN_H
 #define TRAFFIC_PATTERN_H
 
-#include <vector>
+#include "utils/philox_random.h"
+#include <cstdint>
+#include <string>
 
+/**
+ * @brief Where injected packets go
+ *
+ * The engines decide which nodes inject in a cycle and then ask the
+ * pattern for all their destinations in one call, so the virtual dispatch
+ * is paid once per batch rather than once per packet. A pattern is
+ * immutable once built and shared by every simulator of a sweep; random
+ * patterns draw from the caller's stream, addressed by (source, cycle,
+ * kDestinationStream), so results do not depend on which thread asks.
+ */
 class TrafficPattern {
-protected:
-    int networkSize_;
-    double injectionRate;
-
 public:
-    TrafficPattern(int networkSize) : networkSize_(networkSize), injectionRate(0.0) {}
+    // Counter word reserved for destination draws in a run's stream
+    static const uint32_t kDestinationStream = 1;
+
+    explicit TrafficPattern(int networkSize) : networkSize_(networkSize) {}
     virtual ~TrafficPattern() {}
-    
-    virtual void generateTraffic() = 0;
-    virtual std::vector<int> generateTrafficVector() = 0;
-    virtual int generateDestination(int sourceNode) = 0;
-    
-    virtual double getInjectionRate() const { return injectionRate; }
-    virtual void setInjectionRate(double rate) { injectionRate = rate; }
-    
+
+    /**
+     * @brief Destinations of the packets sources inject at cycle
+     * @param stream The run's random stream
+     * @param destinations Receives one entry per source; -1 if that source sends nothing
+     */
+    virtual void fillDestinations(const int* sources, int count, int cycle, const Philox4x32& stream,
+                                  int* destinations) const = 0;
+
+    virtual std::string getName() const = 0;
+
     int getNetworkSize() const { return networkSize_; }
+
+protected:
+    int networkSize_;
+
+private:
+    TrafficPattern(const TrafficPattern&) = delete;
+    TrafficPattern& operator=(const TrafficPattern&) = delete;
 };
 
-#endif // TRAFFIC_PATTERN_H
\ No newline at end of file
+#endif // TRAFFIC_PATTERN_H
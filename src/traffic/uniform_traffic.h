@@ -5,13 +5,21 @@
 
 class UniformTraffic : public TrafficPattern {
 public:
-    UniformTraffic(int networkSize);
-    
-    void generateTraffic() override;
-    std::vector<int> generateTrafficVector() override;
-    int generateDestination(int sourceNode) override;
-    double getInjectionRate() const override;
-    void setInjectionRate(double rate) override;
+    explicit UniformTraffic(int networkSize);
+
+    void fillDestinations(const int* sources, int count, int cycle, const Philox4x32& stream,
+                          int* destinations) const override;
+    std::string getName() const override { return "uniform"; }
+
+    /**
+     * @brief Uniform over every node except source, without rejection
+     */
+    static int destination(const Philox4x32& stream, int source, int cycle, int networkSize) {
+        Philox4x32::Block block = stream(static_cast<uint32_t>(source), static_cast<uint32_t>(cycle),
+                                         kDestinationStream, 0);
+        int destination = static_cast<int>(Philox4x32::toRange(block.v[0], static_cast<uint32_t>(networkSize - 1)));
+        return destination >= source ? destination + 1 : destination;
+    }
 };
 
-#endif // UNIFORM_TRAFFIC_H
\ No newline at end of file
+#endif // UNIFORM_TRAFFIC_H
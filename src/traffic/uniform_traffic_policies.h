@@ -0,0 +1,164 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef UNIFORM_TRAFFIC_POLICIES_H
+#define UNIFORM_TRAFFIC_POLICIES_H
+
+#include "traffic/traffic_pattern.h"
+#include "traffic/uniform_traffic.h"
+#include "utils/philox_random.h"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Uniform Bernoulli injection drawn from counter-based random streams
+ *
+ * The stream key is (run seed, injection rate) and each draw is addressed
+ * by (node, cycle) or (node, injection number), so every decision is a pure
+ * function of its coordinates. Runs give bit-identical results however
+ * replications are spread across threads and in whatever order nodes are
+ * visited.
+ *
+ * Destinations come from the configured TrafficPattern, which draws from
+ * the same stream; without one they are uniform over the other nodes.
+ */
+class CounterUniformTraffic {
+public:
+    explicit CounterUniformTraffic(std::shared_ptr<const TrafficPattern> pattern = nullptr)
+        : pattern_(std::move(pattern)) {}
+
+    /**
+     * @brief Select the stream for one replication
+     */
+    void setStream(uint32_t runSeed, double injectionRate) {
+        random_.setKey(runSeed, static_cast<uint32_t>(std::lround(injectionRate * 1e6)));
+    }
+
+    /**
+     * @brief Nodes of one 64-node block that inject at cycle
+     * @param firstNode First node of the block, a multiple of kBlockNodes
+     * @return Bit i set if node firstNode + i injects
+     *
+     * Costs a number of draws proportional to the injections rather than
+     * to the nodes. Below kSkipSamplingLimit the block is walked with
+     * geometric skips, one draw per injection plus one to leave the
+     * block. Above it, all 64 Bernoulli trials run at once: each lane
+     * compares its bits of a shared uniform against the rate from the
+     * most significant bit down, and the loop stops once every lane has
+     * differed from the rate, after about eight words.
+     */
+    uint64_t injectionMask(int firstNode, int cycle, double injectionRate, int nodeCount) const {
+        uint64_t mask = 0;
+        if (injectionRate <= 0.0) {
+            return mask;
+        }
+        if (injectionRate >= 1.0) {
+            mask = ~uint64_t(0);
+        } else if (injectionRate < kSkipSamplingLimit) {
+            mask = skipSampledMask(firstNode, cycle, injectionRate);
+        } else {
+            mask = bitSlicedMask(firstNode, cycle, injectionRate);
+        }
+
+        int lanes = nodeCount - firstNode;
+        if (lanes < kBlockNodes) {
+            mask &= (uint64_t(1) << lanes) - 1;
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Destinations of injections already known to happen
+     * @param destinations Receives one entry per source; -1 if that source sends nothing
+     */
+    void fillDestinations(const int* sources, int count, int cycle, int nodeCount, int* destinations) const {
+        if (pattern_) {
+            pattern_->fillDestinations(sources, count, cycle, random_, destinations);
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            destinations[i] = UniformTraffic::destination(random_, sources[i], cycle, nodeCount);
+        }
+    }
+
+    /**
+     * @brief Cycles from a node's sequence-th injection to its next one
+     *
+     * Gaps between Bernoulli(injectionRate) successes are geometric.
+     */
+    int injectionGap(int node, int sequence, double injectionRate) const {
+        if (injectionRate >= 1.0) {
+            return 1;
+        }
+        Philox4x32::Block block = random_(static_cast<uint32_t>(node), static_cast<uint32_t>(sequence),
+                                          kGapStream, 0);
+        double u = 1.0 - Philox4x32::toUniform(block.v[0], block.v[1]);
+        double gap = 1.0 + std::floor(std::log(u) / std::log1p(-injectionRate));
+
+        // Far-future gaps only need to land past the end of the run
+        return static_cast<int>(std::fmin(gap, 1e9));
+    }
+
+    static const int kBlockNodes = 64;
+
+private:
+    // Stream 1 is TrafficPattern::kDestinationStream
+    static const uint32_t kGapStream = 2;
+    static const uint32_t kSkipStream = 3;
+    static const uint32_t kMaskStream = 4;
+
+    // Skips cost (64p + 1) / 4 blocks, bit slicing about four
+    static constexpr double kSkipSamplingLimit = 0.2;
+
+    uint64_t skipSampledMask(int firstNode, int cycle, double injectionRate) const {
+        double logNoInjection = std::log1p(-injectionRate);
+        uint64_t mask = 0;
+        double lane = -1.0;
+        for (uint32_t draw = 0;; ++draw) {
+            Philox4x32::Block block = random_(static_cast<uint32_t>(firstNode), static_cast<uint32_t>(cycle),
+                                              kSkipStream, draw);
+            for (int word = 0; word < 4; ++word) {
+                double u = (block.v[word] + 0.5) * (1.0 / 4294967296.0);
+                lane += 1.0 + std::floor(std::log(u) / logNoInjection);
+                if (lane >= kBlockNodes) {
+                    return mask;
+                }
+                mask |= uint64_t(1) << static_cast<int>(lane);
+            }
+        }
+    }
+
+    uint64_t bitSlicedMask(int firstNode, int cycle, double injectionRate) const {
+        // Rate as a 32-bit binary fraction; lanes still tied after it read as u >= rate
+        uint32_t rateBits = static_cast<uint32_t>(injectionRate * 4294967296.0);
+        uint64_t mask = 0;
+        uint64_t undecided = ~uint64_t(0);
+        int bit = 31;
+        for (uint32_t draw = 0; undecided != 0 && bit >= 0; ++draw) {
+            Philox4x32::Block block = random_(static_cast<uint32_t>(firstNode), static_cast<uint32_t>(cycle),
+                                              kMaskStream, draw);
+            for (int word = 0; word < 4 && undecided != 0 && bit >= 0; word += 2, --bit) {
+                uint64_t bits = (static_cast<uint64_t>(block.v[word]) << 32) | block.v[word + 1];
+                if ((rateBits >> bit) & 1) {
+                    mask |= undecided & ~bits;
+                    undecided &= bits;
+                } else {
+                    undecided &= ~bits;
+                }
+            }
+        }
+        return mask;
+    }
+
+    Philox4x32 random_;
+    std::shared_ptr<const TrafficPattern> pattern_;
+};
+
+#endif // UNIFORM_TRAFFIC_POLICIES_H
@@ -13,6 +13,7 @@
 #include <sstream>
 #include <regex>
 #include <cmath>
+#include <algorithm>
 #include <sys/stat.h>
 
 Config::Config() {
@@ -31,6 +32,10 @@ Config::Config() {
     measurementCycles = 10000;
     hotspotRatio = 0.3;
     hotspotNodes = {};
+    trafficMatrixFile = "";
+    trafficMatrixFormat = "sparse";
+    traceCaptureDirectory = "";
+    traceReplayPath = "";
     
     routingAlgorithm = "duato";
     adaptiveThreshold = 2;
@@ -46,6 +51,7 @@ Config::Config() {
     saturationDetection = false;
     latencyThresholdMultiplier = 10.0;
     throughputDropThreshold = 0.1;
+    threadCount = 0;
     
     // Debug defaults - all disabled
     debugEnabled = false;
@@ -56,6 +62,9 @@ Config::Config() {
 
     // Hypercube defaults
     hypercubeDimension = 4;
+    implicitTopology = false;
+    hugePages = false;
+    topologyCacheDirectory = "";
     baselineRouting = "ecube";
     networkTopology = "2D_mesh";
     dimensionPriorities = {0, 1, 2, 3};
@@ -63,6 +72,10 @@ Config::Config() {
     // Simulation info defaults
     simulationName = "omni_simulator - Network Routing Simulation";
     simulationDescription = "Network routing simulation using various protocols";
+    simulationEngine = "cycle";
+    engineThreadCount = 0;
+    enginePartitionCount = 0;
+    optimismWindowCycles = 4;
 }
 
 bool fileExists(const std::string& filename) {
@@ -164,6 +177,9 @@ void Config::parseNetworkConfig(const std::string& content) {
     std::regex topology_regex("\"topology\":\\s*\"([^\"]+)\"");
     std::regex hypercube_dim_regex("\"hypercube_dimension\":\\s*(\\d+)");
     std::regex baseline_routing_regex("\"baseline_routing\":\\s*\"([^\"]+)\"");
+    std::regex implicit_topology_regex("\"implicit_topology\":\\s*(true|false)");
+    std::regex huge_pages_regex("\"huge_pages\":\\s*(true|false)");
+    std::regex topology_cache_regex("\"topology_cache\":\\s*\"([^\"]*)\"");
     
     if (std::regex_search(content, match, topology_regex)) {
         networkTopology = match[1].str();
@@ -174,6 +190,15 @@ void Config::parseNetworkConfig(const std::string& content) {
     if (std::regex_search(content, match, baseline_routing_regex)) {
         baselineRouting = match[1].str();
     }
+    if (std::regex_search(content, match, implicit_topology_regex)) {
+        implicitTopology = (match[1].str() == "true");
+    }
+    if (std::regex_search(content, match, huge_pages_regex)) {
+        hugePages = (match[1].str() == "true");
+    }
+    if (std::regex_search(content, match, topology_cache_regex)) {
+        topologyCacheDirectory = match[1].str();
+    }
 }
 
 void Config::parseTrafficConfig(const std::string& content) {
@@ -182,6 +207,12 @@ void Config::parseTrafficConfig(const std::string& content) {
     std::regex packet_size_regex("\"packet_size_flits\":\\s*(\\d+)");
     std::regex warmup_regex("\"warmup_cycles\":\\s*(\\d+)");
     std::regex measurement_regex("\"measurement_cycles\":\\s*(\\d+)");
+    std::regex hotspot_ratio_regex("\"hotspot_ratio\":\\s*([\\d.]+)");
+    std::regex hotspot_nodes_regex("\"hotspot_nodes\":\\s*\\[([\\d,\\s]*)\\]");
+    std::regex matrix_file_regex("\"matrix_file\":\\s*\"([^\"]*)\"");
+    std::regex matrix_format_regex("\"matrix_format\":\\s*\"([^\"]+)\"");
+    std::regex trace_capture_regex("\"trace_capture\":\\s*\"([^\"]*)\"");
+    std::regex trace_replay_regex("\"trace_replay\":\\s*\"([^\"]*)\"");
     
     // Fix injection rate parsing - support decimals
     std::regex injection_rates_regex("\"packet_injection_rates\":\\s*\\[([\\d.,\\s]+)\\]");
@@ -202,6 +233,38 @@ void Config::parseTrafficConfig(const std::string& content) {
     if (std::regex_search(content, match, measurement_regex)) {
         measurementCycles = std::stoi(match[1].str());
     }
+
+    if (std::regex_search(content, match, hotspot_ratio_regex)) {
+        hotspotRatio = std::stod(match[1].str());
+    }
+
+    if (std::regex_search(content, match, hotspot_nodes_regex)) {
+        hotspotNodes.clear();
+        std::stringstream ss(match[1].str());
+        std::string node;
+        while (std::getline(ss, node, ',')) {
+            node.erase(0, node.find_first_not_of(" \t\r\n"));
+            if (!node.empty()) {
+                hotspotNodes.push_back(std::stoi(node));
+            }
+        }
+    }
+
+    if (std::regex_search(content, match, matrix_file_regex)) {
+        trafficMatrixFile = match[1].str();
+    }
+
+    if (std::regex_search(content, match, matrix_format_regex)) {
+        trafficMatrixFormat = match[1].str();
+    }
+
+    if (std::regex_search(content, match, trace_capture_regex)) {
+        traceCaptureDirectory = match[1].str();
+    }
+
+    if (std::regex_search(content, match, trace_replay_regex)) {
+        traceReplayPath = match[1].str();
+    }
     
     // Parse injection rates array
     if (std::regex_search(content, match, injection_rates_regex)) {
@@ -258,6 +321,10 @@ void Config::parseDebugConfig(const std::string& content) {
 void Config::parseSimulationConfig(const std::string& content) {
     std::regex name_regex("\"name\":\\s*\"([^\"]+)\"");
     std::regex description_regex("\"description\":\\s*\"([^\"]+)\"");
+    std::regex engine_regex("\"engine\":\\s*\"([^\"]+)\"");
+    std::regex engine_threads_regex("\"engine_threads\":\\s*(\\d+)");
+    std::regex partitions_regex("\"partitions\":\\s*(\\d+)");
+    std::regex optimism_window_regex("\"optimism_window\":\\s*(\\d+)");
     
     std::smatch match;
     if (std::regex_search(content, match, name_regex)) {
@@ -267,6 +334,22 @@ void Config::parseSimulationConfig(const std::string& content) {
     if (std::regex_search(content, match, description_regex)) {
         simulationDescription = match[1].str();
     }
+    
+    if (std::regex_search(content, match, engine_regex)) {
+        simulationEngine = match[1].str();
+    }
+    
+    if (std::regex_search(content, match, engine_threads_regex)) {
+        engineThreadCount = std::stoi(match[1].str());
+    }
+    
+    if (std::regex_search(content, match, partitions_regex)) {
+        enginePartitionCount = std::stoi(match[1].str());
+    }
+    
+    if (std::regex_search(content, match, optimism_window_regex)) {
+        optimismWindowCycles = std::max(1, std::stoi(match[1].str()));
+    }
 }
 
 // Getter method implementations
@@ -363,6 +446,10 @@ double Config::getThroughputDropThreshold() const {
     return throughputDropThreshold;
 }
 
+int Config::getThreadCount() const {
+    return threadCount;
+}
+
 int Config::getVirtualChannels() const {
     return virtualChannels;
 }
@@ -379,6 +466,22 @@ std::vector<int> Config::getHotspotNodes() const {
     return hotspotNodes;
 }
 
+std::string Config::getTrafficMatrixFile() const {
+    return trafficMatrixFile;
+}
+
+std::string Config::getTrafficMatrixFormat() const {
+    return trafficMatrixFormat;
+}
+
+std::string Config::getTraceCaptureDirectory() const {
+    return traceCaptureDirectory;
+}
+
+std::string Config::getTraceReplayPath() const {
+    return traceReplayPath;
+}
+
 std::string Config::getRoutingAlgorithm() const {
     return routingAlgorithm;
 }
@@ -396,6 +499,18 @@ int Config::getHypercubeDimension() const {
     return hypercubeDimension;
 }
 
+bool Config::isImplicitTopology() const {
+    return implicitTopology;
+}
+
+bool Config::isHugePagesEnabled() const {
+    return hugePages;
+}
+
+std::string Config::getTopologyCacheDirectory() const {
+    return topologyCacheDirectory;
+}
+
 std::string Config::getBaselineRouting() const {
     return baselineRouting;
 }
@@ -412,9 +527,17 @@ std::string Config::getNetworkTopology() const {
     return networkTopology;
 }
 
-// Simplified implementation using defaults
 void Config::parseRoutingConfig(const std::string& content) {
-    (void)content;
+    std::regex algorithm_regex("\"algorithm\":\\s*\"([^\"]+)\"");
+    
+    std::smatch match;
+    if (std::regex_search(content, match, algorithm_regex)) {
+        routingAlgorithm = match[1].str();
+        // Experiment files name the hypercube variant explicitly
+        if (routingAlgorithm == "duato_hypercube") {
+            routingAlgorithm = "duato";
+        }
+    }
 }
 
 void Config::parseMetricsConfig(const std::string& content) {
@@ -422,7 +545,16 @@ void Config::parseMetricsConfig(const std::string& content) {
 }
 
 void Config::parseExperimentalConfig(const std::string& content) {
-    (void)content;
+    std::regex runs_regex("\"runs_per_injection_rate\":\\s*(\\d+)");
+    std::regex threads_regex("\"threads\":\\s*(\\d+)");
+    
+    std::smatch match;
+    if (std::regex_search(content, match, runs_regex)) {
+        runsPerInjectionRate = std::max(1, std::stoi(match[1].str()));
+    }
+    if (std::regex_search(content, match, threads_regex)) {
+        threadCount = std::stoi(match[1].str());
+    }
 }
 
 // Ensure method implementations match header declarations
@@ -481,4 +613,20 @@ std::string Config::getCompleteSimulationDescription() const {
 // Implement simulation name getter method
 std::string Config::getSimulationName() const {
     return simulationName;
+}
+
+std::string Config::getSimulationEngine() const {
+    return simulationEngine;
+}
+
+int Config::getEngineThreadCount() const {
+    return engineThreadCount;
+}
+
+int Config::getEnginePartitionCount() const {
+    return enginePartitionCount;
+}
+
+int Config::getOptimismWindowCycles() const {
+    return optimismWindowCycles;
 }
\ No newline at end of file
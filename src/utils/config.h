@@ -34,7 +34,11 @@ public:
     int getWarmupCycles() const;
     int getMeasurementCycles() const;
     double getHotspotRatio() const;
-    std::vector<int> getHotspotNodes() const;
+    std::vector<int> getHotspotNodes() const;  // Empty = the last node
+    std::string getTrafficMatrixFile() const;  // Weights read by the "matrix" pattern
+    std::string getTrafficMatrixFormat() const;  // "sparse" (default) or "dense"
+    std::string getTraceCaptureDirectory() const;  // Where each point's injections are recorded, "" = off
+    std::string getTraceReplayPath() const;  // Trace file, or a capture directory, replayed instead of sampling
     
     // Routing configuration getters
     std::string getRoutingAlgorithm() const;
@@ -53,6 +57,7 @@ public:
     bool isSaturationDetectionEnabled() const;
     double getLatencyThresholdMultiplier() const;
     double getThroughputDropThreshold() const;
+    int getThreadCount() const;  // 0 = one per hardware thread
     
     // Debug configuration
     bool isDebugEnabled() const;
@@ -63,6 +68,9 @@ public:
 
     // Hypercube configuration
     int getHypercubeDimension() const;
+    bool isImplicitTopology() const;  // Compute hypercube nodes and links instead of building objects
+    bool isHugePagesEnabled() const;  // Back topology objects with transparent huge pages
+    std::string getTopologyCacheDirectory() const;  // Where compiled routing tables are cached, "" = off
     std::string getBaselineRouting() const;
     bool isHypercubeMode() const;
     std::vector<int> getDimensionPriorities() const;
@@ -76,6 +84,10 @@ public:
     
     // Simulation information methods
     std::string getSimulationName() const;
+    std::string getSimulationEngine() const;  // "cycle" (default), "event", "parallel" or "timewarp"
+    int getEngineThreadCount() const;  // Threads of the parallel engines, 0 = one per hardware thread
+    int getEnginePartitionCount() const;  // Partitions of the parallel engines, 0 = sized from the network
+    int getOptimismWindowCycles() const;  // Cycles a Time Warp partition may run past GVT
     
 private:
     // Network parameters
@@ -94,6 +106,10 @@ private:
     int measurementCycles;
     double hotspotRatio;
     std::vector<int> hotspotNodes;
+    std::string trafficMatrixFile;
+    std::string trafficMatrixFormat;
+    std::string traceCaptureDirectory;
+    std::string traceReplayPath;
     
     // Routing parameters
     std::string routingAlgorithm;
@@ -112,6 +128,7 @@ private:
     bool saturationDetection;
     double latencyThresholdMultiplier;
     double throughputDropThreshold;
+    int threadCount;
     
     // Debug parameters
     bool debugEnabled;
@@ -122,6 +139,9 @@ private:
 
     // Hypercube configuration
     int hypercubeDimension;
+    bool implicitTopology;
+    bool hugePages;
+    std::string topologyCacheDirectory;
     std::string baselineRouting;
     std::vector<int> dimensionPriorities;
     std::string networkTopology;
@@ -129,6 +149,10 @@ private:
     // Simulation information
     std::string simulationName;
     std::string simulationDescription;
+    std::string simulationEngine;
+    int engineThreadCount;
+    int enginePartitionCount;
+    int optimismWindowCycles;
     
     // Helper methods for parsing
     void parseNetworkConfig(const std::string& content);
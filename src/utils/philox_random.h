@@ -0,0 +1,86 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef PHILOX_RANDOM_H
+#define PHILOX_RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @brief Philox4x32-10 counter-based random number generator
+ *
+ * Maps a 128-bit counter and a 64-bit key to 128 random bits with ten
+ * multiply/xor rounds (Salmon et al., "Parallel Random Numbers: As Easy
+ * as 1, 2, 3", SC'11). There is no state to advance: the same (key,
+ * counter) pair always yields the same block, so a simulation can
+ * address its randomness by (run, node, cycle) and get identical draws
+ * regardless of evaluation order or which thread makes them.
+ */
+class Philox4x32 {
+public:
+    struct Block {
+        uint32_t v[4];
+    };
+
+    Philox4x32() : key0_(0), key1_(0) {}
+    Philox4x32(uint32_t key0, uint32_t key1) : key0_(key0), key1_(key1) {}
+
+    void setKey(uint32_t key0, uint32_t key1) {
+        key0_ = key0;
+        key1_ = key1;
+    }
+
+    Block operator()(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) const {
+        uint32_t k0 = key0_;
+        uint32_t k1 = key1_;
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += kWeyl0;
+                k1 += kWeyl1;
+            }
+            uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * c0;
+            uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * c2;
+            uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+            uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<uint32_t>(product1);
+            c3 = static_cast<uint32_t>(product0);
+            c0 = next0;
+            c2 = next2;
+        }
+        Block block = {{c0, c1, c2, c3}};
+        return block;
+    }
+
+    /**
+     * @brief Uniform double in [0, 1) from 53 bits of two words
+     */
+    static double toUniform(uint32_t high, uint32_t low) {
+        uint64_t bits = (static_cast<uint64_t>(high) << 21) ^ (low >> 11);
+        return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Map a word onto [0, n) by multiply-shift
+     *
+     * Bias is at most n / 2^32, far below anything a simulation resolves.
+     */
+    static uint32_t toRange(uint32_t word, uint32_t n) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(word) * n) >> 32);
+    }
+
+private:
+    static const uint32_t kMultiplier0 = 0xD2511F53u;
+    static const uint32_t kMultiplier1 = 0xCD9E8D57u;
+    static const uint32_t kWeyl0 = 0x9E3779B9u;
+    static const uint32_t kWeyl1 = 0xBB67AE85u;
+
+    uint32_t key0_;
+    uint32_t key1_;
+};
+
+#endif // PHILOX_RANDOM_H
@@ -0,0 +1,57 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef SPIN_BARRIER_H
+#define SPIN_BARRIER_H
+
+#include <atomic>
+#include <thread>
+
+/**
+ * @brief Reusable sense-reversing barrier for a fixed team of threads
+ *
+ * The last thread to arrive runs the completion step before releasing
+ * the others, so serial bookkeeping between two parallel phases needs no
+ * extra synchronization. Waiters spin briefly and then yield, which suits
+ * phases of a few microseconds without starving oversubscribed cores.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int parties) : parties_(parties), waiting_(0), sense_(false) {}
+
+    template <typename Completion>
+    void arriveAndWait(Completion&& completion) {
+        bool sense = !sense_.load(std::memory_order_relaxed);
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == parties_) {
+            completion();
+            waiting_.store(0, std::memory_order_relaxed);
+            sense_.store(sense, std::memory_order_release);
+            return;
+        }
+
+        int spins = 0;
+        while (sense_.load(std::memory_order_acquire) != sense) {
+            if (++spins > kSpinsBeforeYield) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void arriveAndWait() {
+        arriveAndWait([] {});
+    }
+
+private:
+    static const int kSpinsBeforeYield = 1024;
+
+    const int parties_;
+    std::atomic<int> waiting_;
+    std::atomic<bool> sense_;
+};
+
+#endif // SPIN_BARRIER_H
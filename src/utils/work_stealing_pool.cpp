@@ -0,0 +1,123 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "utils/work_stealing_pool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : queuedTasks_(0), unfinishedTasks_(0), nextQueue_(0), stopping_(false) {
+    threadCount = std::max(1, threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    workAvailable_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    int queueIndex;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        unfinishedTasks_++;
+        queueIndex = nextQueue_;
+        nextQueue_ = (nextQueue_ + 1) % static_cast<int>(queues_.size());
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+        queues_[queueIndex]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publish under the state lock so a worker cannot miss the wakeup
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        queuedTasks_++;
+    }
+    workAvailable_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    allDone_.wait(lock, [this] { return unfinishedTasks_ == 0; });
+
+    if (firstError_) {
+        std::exception_ptr error = firstError_;
+        firstError_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+int WorkStealingPool::getDefaultThreadCount() {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? static_cast<int>(hardwareThreads) : 1;
+}
+
+void WorkStealingPool::workerLoop(int workerIndex) {
+    for (;;) {
+        Task task;
+        if (!popLocal(workerIndex, task) && !steal(workerIndex, task)) {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            workAvailable_.wait(lock, [this] { return stopping_ || queuedTasks_ > 0; });
+            if (stopping_ && queuedTasks_ == 0) {
+                return;
+            }
+            continue;
+        }
+
+        queuedTasks_--;
+        std::exception_ptr error;
+        try {
+            task(workerIndex);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (error && !firstError_) {
+            firstError_ = error;
+        }
+        if (--unfinishedTasks_ == 0) {
+            allDone_.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(int workerIndex, Task& task) {
+    WorkerQueue& queue = *queues_[workerIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(int workerIndex, Task& task) {
+    int queueCount = static_cast<int>(queues_.size());
+    for (int offset = 1; offset < queueCount; ++offset) {
+        WorkerQueue& victim = *queues_[(workerIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
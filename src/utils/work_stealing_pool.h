@@ -0,0 +1,87 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size thread pool with per-worker deques and work stealing
+ *
+ * Submitted tasks are dealt round-robin onto the worker deques. A worker
+ * runs its own deque in submission order and, when that runs dry, steals
+ * from the tail of the others, so long tasks queued behind one worker do
+ * not leave the rest idle. Submitting the most expensive tasks first
+ * therefore starts them early and leaves cheap ones for thieves. Each
+ * task receives the index of the worker running it, which lets callers
+ * keep per-worker state without locking.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void(int workerIndex)>;
+
+    /**
+     * @brief Start the workers
+     * @param threadCount Number of worker threads (at least one)
+     */
+    explicit WorkStealingPool(int threadCount);
+
+    /**
+     * @brief Finish queued tasks and join the workers
+     */
+    ~WorkStealingPool();
+
+    void submit(Task task);
+
+    /**
+     * @brief Block until every submitted task has finished
+     *
+     * Rethrows the first exception raised by a task, if any.
+     */
+    void wait();
+
+    int getThreadCount() const { return static_cast<int>(workers_.size()); }
+
+    /**
+     * @brief Hardware thread count, or 1 if it cannot be determined
+     */
+    static int getDefaultThreadCount();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int workerIndex);
+    bool popLocal(int workerIndex, Task& task);
+    bool steal(int workerIndex, Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex stateMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;
+    std::atomic<int> queuedTasks_;
+    int unfinishedTasks_;
+    int nextQueue_;
+    bool stopping_;
+    std::exception_ptr firstError_;
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,116 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "traffic/alias_table.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const int kDraws = 1000000;
+
+// Binomial standard deviations a fixed-seed draw may stray from its weight
+const double kTolerance = 5.0;
+
+std::vector<int> drawCounts(const AliasTable& table, uint32_t seed) {
+    Philox4x32 random(seed, 0);
+    std::vector<int> counts(table.size(), 0);
+    for (int draw = 0; draw < kDraws; draw += 2) {
+        Philox4x32::Block block = random(static_cast<uint32_t>(draw), 0, 0, 0);
+        counts[table.sample(block.v[0], block.v[1])]++;
+        counts[table.sample(block.v[2], block.v[3])]++;
+    }
+    return counts;
+}
+
+void checkFrequencies(const std::vector<double>& weights, uint32_t seed) {
+    AliasTable table(weights);
+    CHECK(table.size() == static_cast<int>(weights.size()));
+    std::vector<int> counts = drawCounts(table, seed);
+
+    double total = 0.0;
+    for (double weight : weights) {
+        total += weight;
+    }
+    for (size_t i = 0; i < weights.size(); ++i) {
+        double expected = weights[i] / total;
+        double observed = static_cast<double>(counts[i]) / kDraws;
+        if (weights[i] == 0.0) {
+            CHECK(counts[i] == 0);
+            continue;
+        }
+        double deviation = std::sqrt(expected * (1.0 - expected) / kDraws);
+        if (!CHECK(std::fabs(observed - expected) < kTolerance * deviation)) {
+            std::cerr << "  index " << i << " drawn at " << observed << ", weight share " << expected << std::endl;
+        }
+    }
+}
+
+void testSkewedWeights() {
+    checkFrequencies({0.0, 1.0, 0.0, 100.0, 3.0, 0.0, 0.5, 20.0}, 1);
+    checkFrequencies({1e-3, 1.0, 1e3, 1e6}, 2);
+    checkFrequencies({5.0, 5.0, 5.0}, 3);
+}
+
+void testZeroWeights() {
+    // One non-zero weight among many zeros takes every draw
+    std::vector<double> weights(37, 0.0);
+    weights[17] = 2.5;
+    std::vector<int> counts = drawCounts(AliasTable(weights), 4);
+    CHECK(counts[17] == kDraws);
+
+    // Zeros at both ends and in the middle of a long table
+    weights.assign(1000, 0.0);
+    for (int i = 1; i < 999; i += 3) {
+        weights[i] = 1.0 + (i % 7);
+    }
+    checkFrequencies(weights, 5);
+}
+
+void testExtremeWords() {
+    // The first and last column words and coin words stay in range
+    std::vector<double> weights = {0.0, 3.0, 1.0, 0.0};
+    AliasTable table(weights);
+    const uint32_t words[] = {0u, 1u, 0x7fffffffu, 0x80000000u, 0xfffffffeu, 0xffffffffu};
+    for (uint32_t column : words) {
+        for (uint32_t coin : words) {
+            int index = table.sample(column, coin);
+            CHECK(index == 1 || index == 2);
+        }
+    }
+}
+
+bool rejects(const std::vector<double>& weights) {
+    try {
+        AliasTable table(weights);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testInvalidWeights() {
+    CHECK(rejects({}));
+    CHECK(rejects({0.0, 0.0}));
+    CHECK(rejects({1.0, -0.5}));
+    CHECK(rejects({1.0, std::numeric_limits<double>::quiet_NaN()}));
+    CHECK(rejects({1.0, std::numeric_limits<double>::infinity()}));
+}
+
+} // namespace
+
+int main() {
+    testSkewedWeights();
+    testZeroWeights();
+    testExtremeWords();
+    testInvalidWeights();
+    return test::testStatus();
+}
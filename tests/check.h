@@ -0,0 +1,48 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <iostream>
+
+/**
+ * @brief Minimal assertions for the cc_test targets
+ *
+ * Unlike assert() they stay active in optimized builds. A failed check
+ * prints its location and the test keeps going, so one run reports every
+ * failure; main() returns testStatus().
+ */
+namespace test {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool check(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        failureCount()++;
+    }
+    return passed;
+}
+
+inline int testStatus() {
+    if (failureCount() > 0) {
+        std::cerr << failureCount() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace test
+
+#define CHECK(condition) test::check((condition), #condition, __FILE__, __LINE__)
+
+#endif // TESTS_CHECK_H
@@ -0,0 +1,254 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "metrics/metrics.h"
+#include "simulator/simulation_context.h"
+#include "simulator/simulator.h"
+#include "traffic/injection_trace.h"
+#include "utils/config.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    const char* directory = std::getenv("TEST_TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/" + name;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+bool fileExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+// Records with cycle gaps and field values that need one to five varint bytes
+const InjectionTraceRecord kRecords[] = {
+    {0, 1, 2, 4},
+    {0, 3, 0, 4},
+    {127, 128, 16383, 16384},
+    {(int64_t(1) << 33) + 5, 1048575, 7, 1},
+    {(int64_t(1) << 40) + 99, INT32_MAX, 0, 70000},
+    {(int64_t(1) << 40) + 99, 5, INT32_MAX, 4},
+};
+const size_t kRecordCount = sizeof(kRecords) / sizeof(kRecords[0]);
+
+std::string writeRecords(const std::string& name) {
+    std::string path = tempPath(name);
+    InjectionTraceWriter writer(path, 1 << 20);
+    for (const InjectionTraceRecord& record : kRecords) {
+        writer.append(record.cycle, record.source, record.destination, record.size);
+    }
+    CHECK(writer.getRecordCount() == kRecordCount);
+    writer.close();
+    return path;
+}
+
+void testRecordRoundTrip() {
+    InjectionTraceReader reader(writeRecords("round_trip.trace"));
+    CHECK(reader.getNodeCount() == 1 << 20);
+    CHECK(reader.getRecordCount() == kRecordCount);
+
+    InjectionTraceRecord record;
+    CHECK(!reader.next(-1, record));
+    for (const InjectionTraceRecord& expected : kRecords) {
+        // Nothing is handed out before its cycle
+        if (expected.cycle > 0) {
+            CHECK(!reader.next(expected.cycle - 1, record));
+        }
+        if (!CHECK(reader.next(expected.cycle, record))) {
+            return;
+        }
+        CHECK(record.cycle == expected.cycle);
+        CHECK(record.source == expected.source);
+        CHECK(record.destination == expected.destination);
+        CHECK(record.size == expected.size);
+    }
+    CHECK(!reader.next(INT64_MAX, record));
+}
+
+void testWriterOrdering() {
+    std::string path = tempPath("unclosed.trace");
+    {
+        InjectionTraceWriter writer(path, 16);
+        writer.append(10, 1, 2, 4);
+        bool rejected = false;
+        try {
+            writer.append(9, 1, 2, 4);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        CHECK(rejected);
+    }
+
+    // A writer that was never closed publishes nothing
+    CHECK(!fileExists(path));
+}
+
+/**
+ * @brief Whether opening and reading path to the end fails as a bad trace
+ */
+bool rejectsTrace(const std::string& path) {
+    try {
+        InjectionTraceReader reader(path);
+        InjectionTraceRecord record;
+        while (reader.next(INT64_MAX, record)) {
+        }
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Rewrite the header's payload size so only the records themselves are cut
+std::string withPayloadBytes(std::string trace) {
+    uint64_t payloadBytes = trace.size() - sizeof(InjectionTraceFormat::Header);
+    std::memcpy(&trace[offsetof(InjectionTraceFormat::Header, payloadBytes)], &payloadBytes, sizeof(payloadBytes));
+    return trace;
+}
+
+void testTruncatedTraces() {
+    std::string trace = readFile(writeRecords("whole.trace"));
+    std::string path = tempPath("truncated.trace");
+    CHECK(!rejectsTrace(tempPath("whole.trace")));
+
+    writeFile(path, trace.substr(0, sizeof(InjectionTraceFormat::Header) - 1));
+    CHECK(rejectsTrace(path));
+
+    // Shorter than the header says
+    writeFile(path, trace.substr(0, trace.size() - 1));
+    CHECK(rejectsTrace(path));
+
+    // Cut inside the last record's final varint
+    writeFile(path, withPayloadBytes(trace.substr(0, trace.size() - 1)));
+    CHECK(rejectsTrace(path));
+
+    // Cut after the fifth record: the last one takes 1 + 1 + 5 + 1 bytes
+    writeFile(path, withPayloadBytes(trace.substr(0, trace.size() - 8)));
+    CHECK(rejectsTrace(path));
+
+    writeFile(path, "not a trace at all, just some text that is longer than a header");
+    CHECK(rejectsTrace(path));
+}
+
+void testWideFields() {
+    // Source 2^32 + 1 would wrap to node 1 if read into 32 bits
+    const uint8_t payload[] = {0x00, 0x81, 0x80, 0x80, 0x80, 0x10, 0x02, 0x04};
+    InjectionTraceFormat::Header header;
+    std::memset(&header, 0, sizeof(header));
+    InjectionTraceFormat::fillMagic(header.magic);
+    header.version = InjectionTraceFormat::kVersion;
+    header.byteOrder = InjectionTraceFormat::kByteOrderMark;
+    header.nodeCount = 16;
+    header.recordCount = 1;
+    header.payloadBytes = sizeof(payload);
+
+    std::string trace(reinterpret_cast<const char*>(&header), sizeof(header));
+    trace.append(reinterpret_cast<const char*>(payload), sizeof(payload));
+    std::string path = tempPath("wide.trace");
+    writeFile(path, trace);
+    CHECK(rejectsTrace(path));
+
+    // The same record with source 1 is fine
+    const uint8_t narrow[] = {0x00, 0x01, 0x02, 0x04};
+    header.payloadBytes = sizeof(narrow);
+    trace.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+    trace.append(reinterpret_cast<const char*>(narrow), sizeof(narrow));
+    writeFile(path, trace);
+    CHECK(!rejectsTrace(path));
+}
+
+std::string writeConfig(const std::string& name, const std::string& traceKey, const std::string& traceValue,
+                        int packetSizeFlits) {
+    std::string path = tempPath(name);
+    writeFile(path,
+              "{\n"
+              "  \"simulation\": {\"name\": \"trace test\", \"engine\": \"cycle\"},\n"
+              "  \"network\": {\"topology\": \"hypercube\", \"hypercube_dimension\": 4, \"buffer_size\": 8},\n"
+              "  \"traffic\": {\n"
+              "    \"pattern\": \"uniform\",\n"
+              "    \"packet_size_flits\": " + std::to_string(packetSizeFlits) + ",\n"
+              "    \"warmup_cycles\": 100,\n"
+              "    \"measurement_cycles\": 400,\n"
+              "    \"" + traceKey + "\": \"" + traceValue + "\"\n"
+              "  },\n"
+              "  \"routing\": {\"algorithm\": \"duato_hypercube\"}\n"
+              "}\n");
+    return path;
+}
+
+/**
+ * @brief Run one point and return its per-packet samples and latency histogram as CSV
+ */
+std::string runPoint(const std::string& configPath, double injectionRate) {
+    Config config;
+    CHECK(config.loadConfig(configPath));
+    SimulationContext context(config);
+    context.initialize();
+    Simulator* simulator = context.getSimulator();
+    simulator->setSeed(7);
+    simulator->getMetrics()->setSampleRecording(true);
+    simulator->runSimulation(injectionRate, config);
+
+    std::string samples = tempPath("samples.csv");
+    std::string histogram = tempPath("histogram.csv");
+    simulator->getMetrics()->exportToCSV(samples);
+    simulator->getMetrics()->exportLatencyHistogramCSV(histogram);
+    return readFile(samples) + readFile(histogram);
+}
+
+void testCaptureAndReplay() {
+    std::string directory = tempPath("captured");
+    std::string capture = writeConfig("capture.json", "trace_capture", directory, 4);
+    std::string replay = writeConfig("replay.json", "trace_replay", directory, 4);
+
+    // Below and past saturation, where refused offers reorder deliveries
+    const double rates[] = {0.05, 0.12};
+    for (double rate : rates) {
+        std::string captured = runPoint(capture, rate);
+        CHECK(captured.size() > 1000);
+        CHECK(runPoint(replay, rate) == captured);
+    }
+
+    // Replay reads the size back rather than assuming it
+    bool rejected = false;
+    try {
+        runPoint(writeConfig("resized.json", "trace_replay", directory, 2), rates[0]);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
+
+} // namespace
+
+int main() {
+    testRecordRoundTrip();
+    testWriterOrdering();
+    testTruncatedTraces();
+    testWideFields();
+    testCaptureAndReplay();
+    return test::testStatus();
+}
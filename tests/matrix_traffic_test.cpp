@@ -0,0 +1,130 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "traffic/matrix_traffic.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kNodes = 4;
+
+std::string matrixPath(const std::string& name) {
+    const char* directory = std::getenv("TEST_TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/" + name;
+}
+
+std::string writeMatrix(const std::string& name, const std::string& contents) {
+    std::string path = matrixPath(name);
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+    return path;
+}
+
+/**
+ * @brief Error message from loading contents, or "" if it loaded
+ */
+std::string loadError(const std::string& name, const std::string& format, const std::string& contents) {
+    std::string path = writeMatrix(name, contents);
+    try {
+        MatrixTraffic::load(path, format, kNodes);
+    } catch (const std::invalid_argument& error) {
+        return error.what();
+    }
+    return "";
+}
+
+void expectRejectedAt(const std::string& name, const std::string& format, const std::string& contents,
+                      int line) {
+    std::string error = loadError(name, format, contents);
+    std::string prefix = matrixPath(name) + ":" + std::to_string(line) + ": ";
+    if (!CHECK(error.compare(0, prefix.size(), prefix) == 0)) {
+        std::cerr << "  " << name << ": expected an error at line " << line << ", got \"" << error << "\""
+                  << std::endl;
+    }
+}
+
+void testMalformedSparse() {
+    expectRejectedAt("sparse_word.txt", "sparse", "0 1 1\n# comment\n1 two 1\n", 3);
+    expectRejectedAt("sparse_range.txt", "sparse", "0 1 1\n\n\n2 4 1\n", 4);
+    expectRejectedAt("sparse_negative_id.txt", "sparse", "-1 2 1\n", 1);
+    expectRejectedAt("sparse_fraction.txt", "sparse", "0 1 1\n0.5 2 1\n", 2);
+    expectRejectedAt("sparse_incomplete.txt", "sparse", "0 1 1\n1 2\n", 2);
+    expectRejectedAt("sparse_negative.txt", "sparse", "0 1 1\n1 2 -3\n", 2);
+    expectRejectedAt("sparse_nan.txt", "sparse", "0 1 nan\n", 1);
+    expectRejectedAt("sparse_infinite.txt", "sparse", "0 1 1\r\n1 0 1e999\r\n", 2);
+}
+
+void testMalformedDense() {
+    std::string rows = "0 1 0 0\n0 0 1 0\n";
+    expectRejectedAt("dense_word.txt", "dense", rows + "0 0 x 1\n", 3);
+    expectRejectedAt("dense_short.txt", "dense", rows + "0 0 0 1\n", 4);
+    expectRejectedAt("dense_long.txt", "dense", rows + "0 0 0 1\n1 0 0 0\n# extra\n5\n", 6);
+    expectRejectedAt("dense_negative.txt", "dense", rows + "0 -1 0 1\n1 0 0 0\n", 3);
+}
+
+void testUnreadable() {
+    bool rejected = false;
+    try {
+        MatrixTraffic::load(writeMatrix("valid.txt", "0 1 1\n"), "diagonal", kNodes);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    // A path below a regular file cannot be opened
+    rejected = false;
+    try {
+        MatrixTraffic::load(writeMatrix("not_a_directory", "") + "/matrix.txt", "sparse", kNodes);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
+
+void testLoadedWeights() {
+    // Node 0 favors 3, node 1 only sends to 2, node 2 ignores its diagonal, node 3 is silent
+    std::string path = writeMatrix("weights.txt",
+                                   "# source destination weight\n"
+                                   "0 1 1\n0 2 0\n0 3 9\n"
+                                   "1 2 4.5\n"
+                                   "2 2 7\n2 0 1\n");
+    std::unique_ptr<MatrixTraffic> matrix = MatrixTraffic::load(path, "sparse", kNodes);
+    CHECK(matrix->getClassCount() == 3);
+
+    Philox4x32 stream(7, 0);
+    const int sources[] = {0, 1, 2, 3};
+    std::vector<int> fromZero(kNodes, 0);
+    const int kCycles = 100000;
+    for (int cycle = 0; cycle < kCycles; ++cycle) {
+        int destinations[kNodes];
+        matrix->fillDestinations(sources, kNodes, cycle, stream, destinations);
+        fromZero[destinations[0]]++;
+        CHECK(destinations[1] == 2);
+        CHECK(destinations[2] == 0);
+        CHECK(destinations[3] == -1);
+    }
+    CHECK(fromZero[0] == 0 && fromZero[2] == 0);
+    double share = static_cast<double>(fromZero[3]) / kCycles;
+    CHECK(std::fabs(share - 0.9) < 5.0 * std::sqrt(0.9 * 0.1 / kCycles));
+}
+
+} // namespace
+
+int main() {
+    testMalformedSparse();
+    testMalformedDense();
+    testUnreadable();
+    testLoadedWeights();
+    return test::testStatus();
+}
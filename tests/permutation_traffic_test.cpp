@@ -0,0 +1,110 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "network/topology_policies.h"
+#include "simulator/simulation_topology.h"
+#include "traffic/permutation_traffic.h"
+#include "traffic/permutations.h"
+#include "utils/config.h"
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace {
+
+std::string writeConfig(const std::string& pattern, int width, int height) {
+    const char* directory = std::getenv("TEST_TMPDIR");
+    std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/" + pattern + "_mesh.json";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "{\n"
+           "  \"network\": {\"topology\": \"2D_mesh\", \"width\": " << width << ", \"height\": " << height << "},\n"
+           "  \"traffic\": {\"pattern\": \"" << pattern << "\"},\n"
+           "  \"routing\": {\"algorithm\": \"duato\"}\n"
+           "}\n";
+    return path;
+}
+
+/**
+ * @brief The pattern a mesh of width x height gets through the same path as a simulation
+ */
+std::shared_ptr<const SimulationTopology> buildMesh(const std::string& pattern, int width, int height) {
+    Config config;
+    CHECK(config.loadConfig(writeConfig(pattern, width, height)));
+    return SimulationTopology::build(config);
+}
+
+const PermutationTraffic* permutationOf(const SimulationTopology& topology) {
+    const PermutationTraffic* permutation =
+        dynamic_cast<const PermutationTraffic*>(topology.getTrafficPattern().get());
+    CHECK(permutation != nullptr);
+    return permutation;
+}
+
+// Each coordinate moves independently, in the node numbering the engines use
+void checkDigitwise(const std::string& pattern, int width, int height) {
+    std::shared_ptr<const SimulationTopology> topology = buildMesh(pattern, width, height);
+    const PermutationTraffic* permutation = permutationOf(*topology);
+    if (permutation == nullptr) {
+        return;
+    }
+
+    MeshTopology mesh(width, height);
+    for (int node = 0; node < mesh.getNodeCount(); ++node) {
+        int x = mesh.getX(node);
+        int y = mesh.getY(node);
+        int toX = pattern == "tornado" ? TrafficPermutations::tornadoDigit(x, width)
+                                       : TrafficPermutations::neighborDigit(x, width);
+        int toY = pattern == "tornado" ? TrafficPermutations::tornadoDigit(y, height)
+                                       : TrafficPermutations::neighborDigit(y, height);
+        int expected = toX * height + toY;
+        if (expected == node) {
+            expected = -1;
+        }
+        if (!CHECK(permutation->destinationOf(node) == expected)) {
+            std::cerr << "  " << pattern << " on " << width << "x" << height << ": node (" << x << "," << y
+                      << ") went to " << permutation->destinationOf(node) << ", expected " << expected << std::endl;
+        }
+    }
+}
+
+void testNonSquareMeshes() {
+    checkDigitwise("neighbor", 2, 8);
+    checkDigitwise("tornado", 2, 8);
+    checkDigitwise("neighbor", 8, 2);
+    checkDigitwise("tornado", 8, 3);
+    checkDigitwise("tornado", 5, 7);
+}
+
+void testExactDestinations() {
+    // 2x8 mesh, id = x * 8 + y: (0,1) = 1 steps to (1,2) = 10
+    std::shared_ptr<const SimulationTopology> neighbor = buildMesh("neighbor", 2, 8);
+    const PermutationTraffic* permutation = permutationOf(*neighbor);
+    if (permutation != nullptr) {
+        CHECK(permutation->destinationOf(1) == 10);
+        CHECK(permutation->destinationOf(15) == 0);   // (1,7) wraps to (0,0)
+        CHECK(permutation->destinationOf(7) == 8);    // (0,7) wraps to (1,0)
+    }
+
+    // 4x8 mesh: x moves 1 of 4 (radix 4 tornado), y moves 3 of 8
+    std::shared_ptr<const SimulationTopology> tornado = buildMesh("tornado", 4, 8);
+    permutation = permutationOf(*tornado);
+    if (permutation != nullptr) {
+        CHECK(permutation->destinationOf(0) == 1 * 8 + 3);    // (0,0) to (1,3)
+        CHECK(permutation->destinationOf(3 * 8 + 6) == 0 * 8 + 1);   // (3,6) to (0,1)
+    }
+}
+
+} // namespace
+
+int main() {
+    testNonSquareMeshes();
+    testExactDestinations();
+    return test::testStatus();
+}
@@ -0,0 +1,73 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "utils/philox_random.h"
+
+namespace {
+
+struct KnownAnswer {
+    uint32_t key[2];
+    uint32_t counter[4];
+    uint32_t expected[4];
+};
+
+// philox4x32_10 vectors from Random123's kat_vectors
+const KnownAnswer kKnownAnswers[] = {
+    {{0x00000000u, 0x00000000u},
+     {0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u},
+     {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}},
+    {{0xffffffffu, 0xffffffffu},
+     {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+     {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}},
+    {{0xa4093822u, 0x299f31d0u},
+     {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+     {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}},
+};
+
+void testKnownAnswers() {
+    for (const KnownAnswer& answer : kKnownAnswers) {
+        Philox4x32 random(answer.key[0], answer.key[1]);
+        Philox4x32::Block block = random(answer.counter[0], answer.counter[1], answer.counter[2],
+                                         answer.counter[3]);
+        for (int word = 0; word < 4; ++word) {
+            CHECK(block.v[word] == answer.expected[word]);
+        }
+    }
+}
+
+void testSetKeyMatchesConstructor() {
+    Philox4x32 constructed(0xa4093822u, 0x299f31d0u);
+    Philox4x32 keyed;
+    keyed.setKey(0xa4093822u, 0x299f31d0u);
+    Philox4x32::Block a = constructed(1, 2, 3, 4);
+    Philox4x32::Block b = keyed(1, 2, 3, 4);
+    for (int word = 0; word < 4; ++word) {
+        CHECK(a.v[word] == b.v[word]);
+    }
+}
+
+void testConversions() {
+    CHECK(Philox4x32::toUniform(0, 0) == 0.0);
+    double top = Philox4x32::toUniform(0xffffffffu, 0xffffffffu);
+    CHECK(top < 1.0);
+    CHECK(top > 1.0 - 1e-15);
+
+    CHECK(Philox4x32::toRange(0, 7) == 0);
+    CHECK(Philox4x32::toRange(0xffffffffu, 7) == 6);
+    CHECK(Philox4x32::toRange(0x80000000u, 10) == 5);
+}
+
+} // namespace
+
+int main() {
+    testKnownAnswers();
+    testSetKeyMatchesConstructor();
+    testConversions();
+    return test::testStatus();
+}
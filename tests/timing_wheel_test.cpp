@@ -0,0 +1,77 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "simulator/timing_wheel.h"
+#include <vector>
+
+namespace {
+
+void testDueInScheduleOrder() {
+    TimingWheel<int> wheel;
+    wheel.initialize(6);
+    CHECK(wheel.empty());
+
+    // Everything sent at cycle 10 with the full horizon comes due together
+    wheel.schedule(16, 1);
+    wheel.schedule(13, 2);
+    wheel.schedule(16, 3);
+    CHECK(wheel.size() == 3);
+
+    for (int cycle = 10; cycle < 13; ++cycle) {
+        CHECK(wheel.due(cycle).empty());
+    }
+    CHECK(wheel.due(13) == std::vector<int>({2}));
+    wheel.release(13);
+    CHECK(wheel.size() == 2);
+    CHECK(wheel.due(16) == std::vector<int>({1, 3}));
+    wheel.release(16);
+    CHECK(wheel.empty());
+}
+
+void testFullHorizonDoesNotAlias() {
+    // Scheduling horizon cycles ahead each cycle never lands on a slot still due
+    const int horizon = 8;
+    TimingWheel<int> wheel;
+    wheel.initialize(horizon);
+    for (int cycle = 0; cycle < 100; ++cycle) {
+        const std::vector<int>& due = wheel.due(cycle);
+        if (cycle >= horizon) {
+            CHECK(due == std::vector<int>({cycle - horizon}));
+        } else {
+            CHECK(due.empty());
+        }
+        wheel.release(cycle);
+        wheel.schedule(cycle + horizon, cycle);
+    }
+    CHECK(wheel.size() == static_cast<size_t>(horizon));
+}
+
+void testReinitialize() {
+    TimingWheel<int> wheel;
+    wheel.initialize(2);
+    wheel.schedule(1, 7);
+    wheel.initialize(2);
+    CHECK(wheel.empty());
+    CHECK(wheel.due(1).empty());
+
+    wheel.schedule(2, 5);
+    wheel.initialize(20);
+    CHECK(wheel.empty());
+    wheel.schedule(20, 9);
+    CHECK(wheel.due(20) == std::vector<int>({9}));
+}
+
+} // namespace
+
+int main() {
+    testDueInScheduleOrder();
+    testFullHorizonDoesNotAlias();
+    testReinitialize();
+    return test::testStatus();
+}
@@ -0,0 +1,101 @@
+/*
+ * omni_simulator - Network Routing Simulator
+ * Copyright (c) 2025 nash635
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file for more details.
+ */
+
+#include "check.h"
+#include "traffic/uniform_traffic_policies.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const int kNodeCount = 100;      // One full 64-node block and a partial one
+const int kCycles = 20000;
+
+// Rates on both sides of the skip-sampling / bit-slicing cutoff at 0.2
+const double kRates[] = {0.02, 0.1, 0.19, 0.2, 0.35, 0.8};
+
+// Binomial standard deviations a fixed-seed draw may stray from the rate
+const double kTolerance = 5.0;
+
+std::vector<int> countInjections(const CounterUniformTraffic& traffic, double rate) {
+    std::vector<int> counts(kNodeCount, 0);
+    for (int cycle = 0; cycle < kCycles; ++cycle) {
+        for (int firstNode = 0; firstNode < kNodeCount; firstNode += CounterUniformTraffic::kBlockNodes) {
+            uint64_t mask = traffic.injectionMask(firstNode, cycle, rate, kNodeCount);
+            int lanes = kNodeCount - firstNode;
+            if (lanes < CounterUniformTraffic::kBlockNodes) {
+                CHECK((mask >> lanes) == 0);
+            }
+            for (int lane = 0; lane < CounterUniformTraffic::kBlockNodes && lane < lanes; ++lane) {
+                counts[firstNode + lane] += static_cast<int>((mask >> lane) & 1);
+            }
+        }
+    }
+    return counts;
+}
+
+void testPerNodeRate() {
+    CounterUniformTraffic traffic;
+    for (double rate : kRates) {
+        traffic.setStream(12345, rate);
+        std::vector<int> counts = countInjections(traffic, rate);
+
+        double nodeDeviation = std::sqrt(rate * (1.0 - rate) / kCycles);
+        long long total = 0;
+        for (int node = 0; node < kNodeCount; ++node) {
+            double observed = static_cast<double>(counts[node]) / kCycles;
+            if (!CHECK(std::fabs(observed - rate) < kTolerance * nodeDeviation)) {
+                std::cerr << "  rate " << rate << " node " << node << " injected at " << observed << std::endl;
+            }
+            total += counts[node];
+        }
+
+        double overall = static_cast<double>(total) / (static_cast<double>(kCycles) * kNodeCount);
+        if (!CHECK(std::fabs(overall - rate) < kTolerance * nodeDeviation / std::sqrt(kNodeCount))) {
+            std::cerr << "  rate " << rate << " injected at " << overall << " overall" << std::endl;
+        }
+    }
+}
+
+void testEdgeRates() {
+    CounterUniformTraffic traffic;
+    traffic.setStream(1, 0.0);
+    CHECK(traffic.injectionMask(0, 7, 0.0, kNodeCount) == 0);
+    traffic.setStream(1, 1.0);
+    CHECK(traffic.injectionMask(0, 7, 1.0, kNodeCount) == ~uint64_t(0));
+    CHECK(traffic.injectionMask(64, 7, 1.0, kNodeCount) == (uint64_t(1) << (kNodeCount - 64)) - 1);
+}
+
+void testInjectionGapMean() {
+    CounterUniformTraffic traffic;
+    for (double rate : kRates) {
+        traffic.setStream(12345, rate);
+        double sum = 0.0;
+        for (int sequence = 0; sequence < kCycles; ++sequence) {
+            int gap = traffic.injectionGap(sequence % kNodeCount, sequence / kNodeCount, rate);
+            CHECK(gap >= 1);
+            sum += gap;
+        }
+
+        // Geometric gaps have mean 1 / rate and variance (1 - rate) / rate^2
+        double mean = sum / kCycles;
+        double deviation = std::sqrt((1.0 - rate) / (rate * rate) / kCycles);
+        if (!CHECK(std::fabs(mean - 1.0 / rate) < kTolerance * deviation)) {
+            std::cerr << "  rate " << rate << " mean gap " << mean << std::endl;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    testPerNodeRate();
+    testEdgeRates();
+    testInjectionGapMean();
+    return test::testStatus();
+}